@@ -27,6 +27,8 @@
 #include "stopwatch.hh"
 #include "worklist.hh"
 
+#include <algorithm>
+
 #include <boost/foreach.hpp>
 
 namespace CodeStorage {
@@ -161,6 +163,107 @@ void buildTopList(Graph &cg)
     }
 }
 
+typedef std::vector<Node *>                                     TNodeVect;
+
+/// direct callees of the given node, sorted by uid to keep the order stable
+void calleesOf(TNodeVect &dst, const Node *node)
+{
+    typedef std::map<cl_uid_t, Node *> TNodeByUid;
+    TNodeByUid byUid;
+
+    BOOST_FOREACH(TInsnListByFnc::const_reference item, node->calls) {
+        Fnc *callee = item.first;
+        if (!callee)
+            // ignore indirect calls
+            continue;
+
+        byUid[uidOf(*callee)] = callee->cgNode;
+    }
+
+    BOOST_FOREACH(TNodeByUid::const_reference item, byUid)
+        dst.push_back(item.second);
+}
+
+struct SccFrame {
+    Node           *node;
+    TNodeVect       callees;
+    unsigned        next;
+
+    SccFrame(Node *node_):
+        node(node_),
+        next(0)
+    {
+        calleesOf(callees, node);
+    }
+};
+
+/// Tarjan's algorithm (iterative), emits SCCs in bottom-up topological order
+void buildSccList(Graph &cg, const Storage &stor)
+{
+    typedef std::map<const Node *, int> TIdxMap;
+    TIdxMap index, lowLink;
+    std::set<const Node *> onStack;
+    TNodeVect sccStack;
+    int idx = 0;
+
+    BOOST_FOREACH(Fnc *fnc, stor.fncs) {
+        Node *root = fnc->cgNode;
+        if (!root || hasKey(index, root))
+            continue;
+
+        std::vector<SccFrame> dfs;
+        dfs.push_back(SccFrame(root));
+        index[root] = lowLink[root] = idx++;
+        sccStack.push_back(root);
+        onStack.insert(root);
+
+        while (!dfs.empty()) {
+            SccFrame &frame = dfs.back();
+            Node *node = frame.node;
+
+            if (frame.next < frame.callees.size()) {
+                Node *callee = frame.callees[frame.next++];
+                if (!hasKey(index, callee)) {
+                    // descend to the callee (invalidates the 'frame' reference)
+                    index[callee] = lowLink[callee] = idx++;
+                    sccStack.push_back(callee);
+                    onStack.insert(callee);
+                    dfs.push_back(SccFrame(callee));
+                }
+                else if (hasKey(onStack, callee))
+                    lowLink[node] = std::min(lowLink[node], index[callee]);
+
+                continue;
+            }
+
+            // all callees processed, leave the node
+            dfs.pop_back();
+            if (!dfs.empty()) {
+                const Node *caller = dfs.back().node;
+                lowLink[caller] = std::min(lowLink[caller], lowLink[node]);
+            }
+
+            if (lowLink[node] != index[node])
+                // not a root of SCC
+                continue;
+
+            // pop the whole SCC from the stack
+            const int sccIdx = cg.sccs.size();
+            cg.sccs.push_back(TFncList());
+            TFncList &scc = cg.sccs.back();
+            Node *member;
+            do {
+                member = sccStack.back();
+                sccStack.pop_back();
+                onStack.erase(member);
+                member->scc = sccIdx;
+                scc.push_back(member->fnc);
+            }
+            while (member != node);
+        }
+    }
+}
+
 void buildCallGraph(const Storage &stor)
 {
     StopWatch watch;
@@ -179,6 +282,9 @@ void buildCallGraph(const Storage &stor)
     // construct topological order
     buildTopList(cg);
 
+    // construct the condensed graph of strongly connected components
+    buildSccList(cg, stor);
+
     CL_DEBUG("buildCallGraph() took " << watch);
 }
 
@@ -59,8 +59,7 @@ public:   // methods
 
 		Index<size_t> stateIndex;
 		fae_.getRoot(root)->buildStateIndex(stateIndex);
-		std::vector<std::vector<bool>> rel(stateIndex.size(),
-			std::vector<bool>(stateIndex.size(), true));
+		BitMatrix rel(stateIndex.size(), true);
 
 		// compute the abstraction (i.e. which states are to be merged)
 		fae_.getRoot(root)->heightAbstraction(rel, height, f, stateIndex);
@@ -113,8 +112,7 @@ public:   // methods
 		FA_NOTE("Index: " << faeStateIndex);
 
 		// create the initial relation
-		// TODO: use boost::dynamic_bitset
-		std::vector<std::vector<bool>> rel;
+		BitMatrix rel;
 
 		if (!predicates.empty())
 		{
@@ -140,7 +138,7 @@ public:   // methods
 			FA_NOTE("matchWith: " << oss.str());
 
 			// create the relation
-			rel.assign(numStates, std::vector<bool>(numStates, false));
+			rel.assign(numStates, false);
 			for (size_t i = 0; i < numStates; ++i)
 			{
 				rel[i][i] = true;
@@ -158,7 +156,7 @@ public:   // methods
 		else
 		{
 			// create universal relation
-			rel.assign(numStates, std::vector<bool>(numStates, true));
+			rel.assign(numStates, true);
 		}
 
 		for (size_t i = 0; i < fae_.getRootCount(); ++i)
@@ -205,7 +203,7 @@ public:   // methods
 		}
 
 		std::ostringstream oss;
-		utils::relPrint(oss, rel);
+		oss << rel;
 		FA_NOTE("Relation: \n" << oss.str());
 
 		std::ostringstream ossInd;
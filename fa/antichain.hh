@@ -27,6 +27,7 @@
 #include <functional>
 #include <algorithm>
 
+#include "bitmatrix.hh"
 #include "cache.hh"
 
 class Antichain {
@@ -47,7 +48,7 @@ protected:
 	typedef std::list<state_cache_type::value_type*> antichain_item_type;
 	typedef std::unordered_map<size_t, antichain_item_type> antichain_type;
 
-	const std::vector<std::vector<bool> >& rel;
+	const BitMatrix& rel;
 	
 	std::vector<std::vector<size_t> > relIndex;
 	std::vector<std::vector<size_t> > invRelIndex;
@@ -174,11 +175,11 @@ protected:
 
 public:
 
-	Antichain(const std::vector<std::vector<bool> >& rel) : stateCache{}, cachedLte{}, rel(rel), relIndex{}, invRelIndex{}, stateCacheListener(*this), processed{}, next{} {
-		utils::relIndex(this->relIndex, rel);
-		std::vector<std::vector<bool> > invRel;
-		utils::relInv(invRel, rel);
-		utils::relIndex(this->invRelIndex, invRel);
+	Antichain(const BitMatrix& rel) : stateCache{}, cachedLte{}, rel(rel), relIndex{}, invRelIndex{}, stateCacheListener(*this), processed{}, next{} {
+		rel.buildIndex(this->relIndex);
+		BitMatrix invRel;
+		rel.transposed(invRel);
+		invRel.buildIndex(this->invRelIndex);
 	}
 	
 	void initialize(const std::vector<std::pair<size_t, std::set<size_t> > >& post) {
@@ -86,7 +86,7 @@ public:
 
 public:
 
-	AntichainExt(const std::vector<std::vector<bool> >& rel) :
+	AntichainExt(const BitMatrix& rel) :
 		Antichain(rel),
 		aTransIndex{}
 	{ }
@@ -194,15 +194,9 @@ public:
 		for (size_t i = 0; i < cSize; ++i)
 			stateIndex.add(i);
 		// compute simulation
-		std::vector<std::vector<bool>> upsim, dwnsim, ident(cSize, std::vector<bool>(cSize, false));
-		for (size_t i = 0; i < cSize; ++i)
-		{
-			ident[i][i] = true;
-		}
-
-		upsim = ident;
+		const BitMatrix upsim = BitMatrix::identity(cSize);
 		std::vector<std::vector<size_t> > upsimIndex;
-		utils::relIndex(upsimIndex, upsim);
+		upsim.buildIndex(upsimIndex);
 		AntichainExt<T> antichain(upsim);
 		typename AntichainExt<T>::ResponseExt response(antichain);
 		antichain.initIndex(cSize - countB, countB);
@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+// Standard library headers
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief  Square matrix of bits representing a binary relation
+ *
+ * The matrix is stored row by row in a single contiguous array of machine
+ * words, so that operations over whole rows (intersection, union, difference,
+ * emptiness and inclusion checks) are performed a word at a time and the
+ * compiler is free to vectorize them.  Single elements can be accessed using
+ * the usual @p rel[i][j] notation.
+ */
+class BitMatrix
+{
+public:   // data types
+
+	typedef uint64_t word_type;
+
+	static const size_t WORD_BITS = 8 * sizeof(word_type);
+
+	/**
+	 * @brief  Reference to a single element of the matrix
+	 */
+	class BitRef
+	{
+		word_type& word_;
+		word_type mask_;
+
+	public:
+
+		BitRef(word_type& word, word_type mask) :
+			word_(word),
+			mask_(mask)
+		{ }
+
+		operator bool() const { return 0 != (word_ & mask_); }
+
+		BitRef& operator=(bool value)
+		{
+			if (value)
+				word_ |= mask_;
+			else
+				word_ &= ~mask_;
+
+			return *this;
+		}
+
+		BitRef& operator=(const BitRef& rhs)
+		{
+			return *this = static_cast<bool>(rhs);
+		}
+	};
+
+	/**
+	 * @brief  Proxy of a row of the matrix (allows for @p rel[i][j] = x)
+	 */
+	class RowRef
+	{
+		word_type* row_;
+
+	public:
+
+		explicit RowRef(word_type* row) :
+			row_(row)
+		{ }
+
+		BitRef operator[](size_t j) const
+		{
+			return BitRef(row_[j / WORD_BITS], word_type(1) << (j % WORD_BITS));
+		}
+	};
+
+	/**
+	 * @brief  Read-only proxy of a row of the matrix
+	 */
+	class ConstRowRef
+	{
+		const word_type* row_;
+
+	public:
+
+		explicit ConstRowRef(const word_type* row) :
+			row_(row)
+		{ }
+
+		bool operator[](size_t j) const
+		{
+			return 0 != (row_[j / WORD_BITS] & (word_type(1) << (j % WORD_BITS)));
+		}
+	};
+
+private:  // data members
+
+	size_t size_;
+	size_t stride_;
+	std::vector<word_type> data_;
+
+private:  // methods
+
+	static size_t wordsFor(size_t size)
+	{
+		return (size + WORD_BITS - 1) / WORD_BITS;
+	}
+
+	word_type* row(size_t i)
+	{
+		assert(i < size_);
+		return &data_[i * stride_];
+	}
+
+	const word_type* row(size_t i) const
+	{
+		assert(i < size_);
+		return &data_[i * stride_];
+	}
+
+	/// mask of the bits of the last word of a row which are really used
+	word_type tailMask() const
+	{
+		const size_t rem = size_ % WORD_BITS;
+		return (rem) ? ((word_type(1) << rem) - 1) : ~word_type(0);
+	}
+
+	/// clears the unused bits at the end of each row (keeps rows comparable)
+	void clearTail()
+	{
+		if (!stride_)
+			return;
+
+		const word_type mask = this->tailMask();
+		for (size_t i = 0; i < size_; ++i)
+			this->row(i)[stride_ - 1] &= mask;
+	}
+
+public:   // methods
+
+	/**
+	 * @brief  Creates a @p size x @p size matrix with all elements set to @p value
+	 */
+	explicit BitMatrix(size_t size = 0, bool value = false) :
+		size_(size),
+		stride_(wordsFor(size)),
+		data_(size * wordsFor(size), (value) ? ~word_type(0) : word_type(0))
+	{
+		this->clearTail();
+	}
+
+	static BitMatrix identity(size_t size)
+	{
+		BitMatrix rel(size, false);
+		for (size_t i = 0; i < size; ++i)
+			rel[i][i] = true;
+
+		return rel;
+	}
+
+	size_t size() const { return size_; }
+
+	RowRef operator[](size_t i) { return RowRef(this->row(i)); }
+
+	ConstRowRef operator[](size_t i) const { return ConstRowRef(this->row(i)); }
+
+	/**
+	 * @brief  Re-initializes the matrix to @p size x @p size elements of @p value
+	 */
+	void assign(size_t size, bool value)
+	{
+		size_ = size;
+		stride_ = wordsFor(size);
+		data_.assign(size * stride_, (value) ? ~word_type(0) : word_type(0));
+		this->clearTail();
+	}
+
+	/**
+	 * @brief  Enlarges (or shrinks) the matrix while keeping its contents
+	 *
+	 * Elements that are newly added to the matrix are set to @p value.
+	 */
+	void resize(size_t size, bool value)
+	{
+		BitMatrix tmp(size, value);
+		const size_t common = std::min(size, size_);
+		const size_t words = common / WORD_BITS;
+		for (size_t i = 0; i < common; ++i)
+		{
+			// whole words first, then the remaining bits one by one
+			std::copy(this->row(i), this->row(i) + words, tmp.row(i));
+			for (size_t j = words * WORD_BITS; j < common; ++j)
+				tmp[i][j] = (*this)[i][j];
+		}
+
+		this->swap(tmp);
+	}
+
+	void fill(bool value)
+	{
+		std::fill(data_.begin(), data_.end(),
+			(value) ? ~word_type(0) : word_type(0));
+		this->clearTail();
+	}
+
+	void swap(BitMatrix& rhs)
+	{
+		std::swap(size_, rhs.size_);
+		std::swap(stride_, rhs.stride_);
+		data_.swap(rhs.data_);
+	}
+
+	/**
+	 * @brief  Element-wise conjunction with another relation of the same size
+	 */
+	BitMatrix& operator&=(const BitMatrix& rhs)
+	{
+		assert(size_ == rhs.size_);
+		for (size_t k = 0; k < data_.size(); ++k)
+			data_[k] &= rhs.data_[k];
+
+		return *this;
+	}
+
+	/**
+	 * @brief  Element-wise disjunction with another relation of the same size
+	 */
+	BitMatrix& operator|=(const BitMatrix& rhs)
+	{
+		assert(size_ == rhs.size_);
+		for (size_t k = 0; k < data_.size(); ++k)
+			data_[k] |= rhs.data_[k];
+
+		return *this;
+	}
+
+	/**
+	 * @brief  Removes all pairs that are present in @p rhs
+	 */
+	BitMatrix& andNot(const BitMatrix& rhs)
+	{
+		assert(size_ == rhs.size_);
+		for (size_t k = 0; k < data_.size(); ++k)
+			data_[k] &= ~rhs.data_[k];
+
+		return *this;
+	}
+
+	bool operator==(const BitMatrix& rhs) const
+	{
+		return (size_ == rhs.size_) && (data_ == rhs.data_);
+	}
+
+	bool operator!=(const BitMatrix& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	/**
+	 * @brief  Row @p i (of this) AND row @p j (of @p rhs) is non-empty
+	 */
+	bool rowIntersects(size_t i, const BitMatrix& rhs, size_t j) const
+	{
+		assert(stride_ == rhs.stride_);
+		const word_type* a = this->row(i);
+		const word_type* b = rhs.row(j);
+		for (size_t k = 0; k < stride_; ++k)
+		{
+			if (a[k] & b[k])
+				return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief  Row @p i (of this) is a subset of row @p j (of @p rhs)
+	 */
+	bool rowSubsetOf(size_t i, const BitMatrix& rhs, size_t j) const
+	{
+		assert(stride_ == rhs.stride_);
+		const word_type* a = this->row(i);
+		const word_type* b = rhs.row(j);
+		for (size_t k = 0; k < stride_; ++k)
+		{
+			if (a[k] & ~b[k])
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief  Copies row @p j of @p src into row @p i of this
+	 */
+	void copyRow(size_t i, const BitMatrix& src, size_t j)
+	{
+		assert(stride_ == src.stride_);
+		std::copy(src.row(j), src.row(j) + stride_, this->row(i));
+	}
+
+	/**
+	 * @brief  Computes the transposed (inverse) relation
+	 */
+	void transposed(BitMatrix& dst) const
+	{
+		dst.assign(size_, false);
+		for (size_t i = 0; i < size_; ++i)
+		{
+			const word_type* r = this->row(i);
+			for (size_t k = 0; k < stride_; ++k)
+			{
+				for (word_type w = r[k]; w; w &= w - 1)
+					dst[k * WORD_BITS + __builtin_ctzll(w)][i] = true;
+			}
+		}
+	}
+
+	/**
+	 * @brief  Appends the (sorted) indices of elements in row @p i to @p dst
+	 */
+	void rowIndex(std::vector<size_t>& dst, size_t i) const
+	{
+		const word_type* r = this->row(i);
+		for (size_t k = 0; k < stride_; ++k)
+		{
+			for (word_type w = r[k]; w; w &= w - 1)
+				dst.push_back(k * WORD_BITS + __builtin_ctzll(w));
+		}
+	}
+
+	/**
+	 * @brief  Builds a sparse index of the relation
+	 *
+	 * For each element @p i, @p dst[i] is the sorted list of all elements
+	 * @p j such that (@p i, @p j) is in the relation.
+	 */
+	void buildIndex(std::vector<std::vector<size_t>>& dst) const
+	{
+		dst.resize(size_);
+		for (size_t i = 0; i < size_; ++i)
+			this->rowIndex(dst[i], i);
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const BitMatrix& rel)
+	{
+		for (size_t i = 0; i < rel.size(); ++i)
+		{
+			for (size_t j = 0; j < rel.size(); ++j)
+				os << rel[i][j];
+			os << std::endl;
+		}
+
+		return os;
+	}
+};
+
+#endif
@@ -0,0 +1,828 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Standard library headers
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+// Forester headers
+#include "boxdb.hh"
+#include "boxman.hh"
+#include "streams.hh"
+
+namespace
+{	// anonymous namespace
+
+/// the magic string at the beginning of the database file
+const char MAGIC[] = "FABOXDB";
+
+/// the name of the database file in the root directory
+const char FILE_NAME[] = "boxes.fadb";
+
+enum class label_kind_e : uint8_t
+{
+	l_data,
+	l_node
+};
+
+enum class item_kind_e : uint8_t
+{
+	i_sel,
+	i_type,
+	i_box
+};
+
+/**
+ * @brief  Thrown when a box cannot be stored (e.g. it refers to native pointers)
+ */
+struct UnsupportedBox
+{ };
+
+/**
+ * @brief  Appends integers and strings to a buffer (in the little endian)
+ */
+class Writer
+{
+private:  // data members
+
+	std::string& buf_;
+
+public:   // methods
+
+	explicit Writer(std::string& buf) :
+		buf_(buf)
+	{ }
+
+	void put8(uint8_t x)
+	{
+		buf_.push_back(static_cast<char>(x));
+	}
+
+	void put32(uint32_t x)
+	{
+		for (size_t i = 0; i < 4; ++i, x >>= 8)
+			this->put8(static_cast<uint8_t>(x & 0xff));
+	}
+
+	void put64(uint64_t x)
+	{
+		for (size_t i = 0; i < 8; ++i, x >>= 8)
+			this->put8(static_cast<uint8_t>(x & 0xff));
+	}
+
+	void putInt(int x)
+	{
+		this->put32(static_cast<uint32_t>(x));
+	}
+
+	void putString(const std::string& str)
+	{
+		this->put32(static_cast<uint32_t>(str.size()));
+		buf_.append(str);
+	}
+};
+
+/**
+ * @brief  Reads integers and strings written by Writer
+ *
+ * Throws std::runtime_error when reading past the end of the buffer.
+ */
+class Reader
+{
+private:  // data members
+
+	const std::string& buf_;
+
+	size_t pos_;
+
+	void require(size_t size) const
+	{
+		if (buf_.size() - pos_ < size)
+			throw std::runtime_error("truncated box database");
+	}
+
+public:   // methods
+
+	explicit Reader(const std::string& buf) :
+		buf_(buf),
+		pos_(0)
+	{ }
+
+	bool atEnd() const
+	{
+		return pos_ == buf_.size();
+	}
+
+	uint8_t get8()
+	{
+		this->require(1);
+		return static_cast<uint8_t>(buf_[pos_++]);
+	}
+
+	uint32_t get32()
+	{
+		uint32_t x = 0;
+		for (size_t i = 0; i < 4; ++i)
+			x |= static_cast<uint32_t>(this->get8()) << (8 * i);
+
+		return x;
+	}
+
+	uint64_t get64()
+	{
+		uint64_t x = 0;
+		for (size_t i = 0; i < 8; ++i)
+			x |= static_cast<uint64_t>(this->get8()) << (8 * i);
+
+		return x;
+	}
+
+	int getInt()
+	{
+		return static_cast<int>(this->get32());
+	}
+
+	std::string getString()
+	{
+		const size_t size = this->get32();
+		this->require(size);
+		std::string str = buf_.substr(pos_, size);
+		pos_ += size;
+		return str;
+	}
+
+	/// reads a count of items, each of them occupying at least @p itemSize bytes
+	size_t getCount(size_t itemSize = 1)
+	{
+		const size_t count = this->get32();
+		this->require(count * itemSize);
+		return count;
+	}
+};
+
+
+/**
+ * @brief  Serializes a box with all nested boxes into a database record
+ */
+class BoxEncoder
+{
+private:  // data members
+
+	/// nested boxes first, the encoded box last
+	std::vector<const Box*> closure_;
+
+	std::unordered_map<const Box*, size_t> boxIndex_;
+
+	/// the type signature (type name -> selectors)
+	std::map<std::string, std::vector<size_t>> types_;
+
+	std::string payload_;
+
+	Writer out_;
+
+private:  // methods
+
+	void collect(const Box& box)
+	{
+		if (boxIndex_.count(&box))
+			return;
+
+		const TreeAut* tas[] = { box.getOutput(), box.getInput() };
+		for (const TreeAut* ta : tas)
+		{
+			if (nullptr == ta)
+				continue;
+
+			for (const TT<label_type>& trans : *ta)
+			{
+				if (!trans.label()->isNode())
+					continue;
+
+				for (const AbstractBox* aBox : trans.label()->getNode())
+				{
+					if (box_type_e::bBox == aBox->getType())
+						this->collect(*static_cast<const Box*>(aBox));
+				}
+			}
+		}
+
+		boxIndex_.insert(std::make_pair(&box, closure_.size()));
+		closure_.push_back(&box);
+	}
+
+	void encodeSelData(const SelData& sel)
+	{
+		out_.put64(sel.offset);
+		out_.putInt(sel.size);
+		out_.putInt(sel.displ);
+		out_.putString(sel.name);
+	}
+
+	void encodeData(const Data& data)
+	{
+		out_.put8(static_cast<uint8_t>(data.type));
+		out_.putInt(data.size);
+
+		switch (data.type)
+		{
+			case data_type_e::t_native_ptr:
+				throw UnsupportedBox();
+			case data_type_e::t_void_ptr:
+				out_.put64(data.d_void_ptr_size); break;
+			case data_type_e::t_ref:
+				out_.put64(data.d_ref.root);
+				out_.putInt(data.d_ref.displ); break;
+			case data_type_e::t_int:
+				out_.putInt(data.d_int); break;
+			case data_type_e::t_bool:
+				out_.put8(data.d_bool); break;
+			case data_type_e::t_struct:
+				out_.put32(static_cast<uint32_t>(data.d_struct->size()));
+				for (const Data::item_info& item : *data.d_struct)
+				{
+					out_.put64(item.first);
+					this->encodeData(item.second);
+				}
+				break;
+			default: break;
+		}
+	}
+
+	void encodeLabel(const NodeLabel& label)
+	{
+		if (label.isData())
+		{
+			out_.put8(static_cast<uint8_t>(label_kind_e::l_data));
+			this->encodeData(label.getData());
+			return;
+		}
+
+		if (!label.isNode())
+			throw UnsupportedBox();
+
+		out_.put8(static_cast<uint8_t>(label_kind_e::l_node));
+		out_.put32(static_cast<uint32_t>(label.getNode().size()));
+		for (const AbstractBox* aBox : label.getNode())
+		{
+			switch (aBox->getType())
+			{
+				case box_type_e::bSel:
+					out_.put8(static_cast<uint8_t>(item_kind_e::i_sel));
+					this->encodeSelData(static_cast<const SelBox*>(aBox)->getData());
+					break;
+				case box_type_e::bTypeInfo:
+				{
+					const TypeBox* typeBox = static_cast<const TypeBox*>(aBox);
+					out_.put8(static_cast<uint8_t>(item_kind_e::i_type));
+					out_.putString(typeBox->getName());
+					types_[typeBox->getName()] = typeBox->getSelectors();
+					break;
+				}
+				case box_type_e::bBox:
+					out_.put8(static_cast<uint8_t>(item_kind_e::i_box));
+					out_.put32(static_cast<uint32_t>(
+						boxIndex_.at(static_cast<const Box*>(aBox))));
+					break;
+				default:
+					throw UnsupportedBox();
+			}
+		}
+
+		const std::vector<SelData>* sels = label.node.sels;
+		out_.put8(nullptr != sels);
+		if (nullptr != sels)
+		{
+			out_.put32(static_cast<uint32_t>(sels->size()));
+			for (const SelData& sel : *sels)
+				this->encodeSelData(sel);
+		}
+	}
+
+	void encodeTA(
+		const TreeAut&                                    ta,
+		const std::unordered_map<label_type, size_t>&     labels)
+	{
+		out_.put32(static_cast<uint32_t>(ta.getFinalStates().size()));
+		for (size_t state : ta.getFinalStates())
+			out_.put64(state);
+
+		out_.put32(static_cast<uint32_t>(ta.getTransitions().size()));
+		for (const TT<label_type>& trans : ta)
+		{
+			out_.put32(static_cast<uint32_t>(labels.at(trans.label())));
+			out_.put32(static_cast<uint32_t>(trans.lhs().size()));
+			for (size_t state : trans.lhs())
+				out_.put64(state);
+
+			out_.put64(trans.rhs());
+		}
+	}
+
+	void encodeSignature(const ConnectionGraph::CutpointSignature& signature)
+	{
+		out_.put32(static_cast<uint32_t>(signature.size()));
+		for (const ConnectionGraph::CutpointInfo& cutpoint : signature)
+		{
+			out_.put64(cutpoint.root);
+			out_.put64(cutpoint.refCount);
+			out_.put64(cutpoint.selCount);
+			out_.put8(cutpoint.refInherited);
+			out_.put32(static_cast<uint32_t>(cutpoint.fwdSelectors.size()));
+			for (size_t sel : cutpoint.fwdSelectors)
+				out_.put64(sel);
+
+			out_.put64(cutpoint.bwdSelector);
+			out_.put32(static_cast<uint32_t>(cutpoint.defines.size()));
+			for (size_t sel : cutpoint.defines)
+				out_.put64(sel);
+		}
+	}
+
+	void encodeBox(const Box& box)
+	{
+		// the table of labels used in the automata of the box
+		std::unordered_map<label_type, size_t> labels;
+		std::vector<label_type> labelOrder;
+		const TreeAut* tas[] = { box.getOutput(), box.getInput() };
+		for (const TreeAut* ta : tas)
+		{
+			if (nullptr == ta)
+				continue;
+
+			for (const TT<label_type>& trans : *ta)
+			{
+				if (labels.insert(std::make_pair(trans.label(), labels.size())).second)
+					labelOrder.push_back(trans.label());
+			}
+		}
+
+		out_.put32(static_cast<uint32_t>(labelOrder.size()));
+		for (const label_type& label : labelOrder)
+			this->encodeLabel(*label);
+
+		this->encodeTA(*box.getOutput(), labels);
+		this->encodeSignature(box.getOutputSignature());
+		out_.put32(static_cast<uint32_t>(box.getInputMap().size()));
+		for (size_t sel : box.getInputMap())
+			out_.put64(sel);
+
+		out_.put8(nullptr != box.getInput());
+		if (nullptr != box.getInput())
+			this->encodeTA(*box.getInput(), labels);
+
+		out_.put64(box.getInputIndex());
+		this->encodeSignature(box.getInputSignature());
+		out_.put32(static_cast<uint32_t>(box.getSelectors().size()));
+		for (const std::pair<size_t, size_t>& sel : box.getSelectors())
+		{
+			out_.put64(sel.first);
+			out_.put64(sel.second);
+		}
+	}
+
+public:   // methods
+
+	BoxEncoder() :
+		closure_{},
+		boxIndex_{},
+		types_{},
+		payload_{},
+		out_(payload_)
+	{ }
+
+	/**
+	 * @brief  Encodes @p box into a record (throws UnsupportedBox)
+	 */
+	BoxDb::Record encode(const Box& box)
+	{
+		this->collect(box);
+
+		out_.put32(static_cast<uint32_t>(closure_.size()));
+		for (const Box* nested : closure_)
+			this->encodeBox(*nested);
+
+		BoxDb::Record record;
+		Writer key(record.key);
+		key.put32(static_cast<uint32_t>(types_.size()));
+		for (const auto& type : types_)
+		{
+			key.putString(type.first);
+			key.put32(static_cast<uint32_t>(type.second.size()));
+			for (size_t sel : type.second)
+				key.put64(sel);
+		}
+
+		record.payload.swap(payload_);
+
+		return record;
+	}
+};
+
+
+/**
+ * @brief  Loads boxes from a database record into a box manager
+ */
+class BoxDecoder
+{
+private:  // data members
+
+	BoxMan& boxMan_;
+
+	TreeAut::Backend& backend_;
+
+	/// the loaded boxes in the order of the record
+	std::vector<const Box*> boxes_;
+
+private:  // methods
+
+	static void check(bool cond)
+	{
+		if (!cond)
+			throw std::runtime_error("corrupted box database");
+	}
+
+	SelData decodeSelData(Reader& in)
+	{
+		const size_t offset = in.get64();
+		const int size = in.getInt();
+		const int displ = in.getInt();
+		return SelData(offset, size, displ, in.getString());
+	}
+
+	Data decodeData(Reader& in)
+	{
+		const uint8_t type = in.get8();
+		check(type <= static_cast<uint8_t>(data_type_e::t_other));
+
+		Data data(static_cast<data_type_e>(type));
+		data.size = in.getInt();
+
+		switch (data.type)
+		{
+			case data_type_e::t_native_ptr:
+				check(false); break;
+			case data_type_e::t_void_ptr:
+				data.d_void_ptr_size = in.get64(); break;
+			case data_type_e::t_ref:
+				data.d_ref.root = in.get64();
+				data.d_ref.displ = in.getInt(); break;
+			case data_type_e::t_int:
+				data.d_int = in.getInt(); break;
+			case data_type_e::t_bool:
+				data.d_bool = in.get8(); break;
+			case data_type_e::t_struct:
+			{
+				std::vector<Data::item_info> items;
+				for (size_t i = in.getCount(); i > 0; --i)
+				{
+					const size_t offset = in.get64();
+					items.push_back(std::make_pair(offset, this->decodeData(in)));
+				}
+
+				data.d_struct = new std::vector<Data::item_info>(items);
+				break;
+			}
+			default: break;
+		}
+
+		return data;
+	}
+
+	label_type decodeLabel(Reader& in)
+	{
+		const uint8_t kind = in.get8();
+		if (static_cast<uint8_t>(label_kind_e::l_data) == kind)
+			return boxMan_.lookupLabel(this->decodeData(in));
+
+		check(static_cast<uint8_t>(label_kind_e::l_node) == kind);
+
+		std::vector<const AbstractBox*> node;
+		const TypeBox* typeBox = nullptr;
+		for (size_t i = in.getCount(); i > 0; --i)
+		{
+			switch (static_cast<item_kind_e>(in.get8()))
+			{
+				case item_kind_e::i_sel:
+					node.push_back(boxMan_.getSelector(this->decodeSelData(in)));
+					break;
+				case item_kind_e::i_type:
+					typeBox = boxMan_.getTypeInfo(in.getString());
+					node.push_back(typeBox);
+					break;
+				case item_kind_e::i_box:
+				{
+					const size_t index = in.get32();
+					check(index < boxes_.size());
+					node.push_back(boxes_[index]);
+					break;
+				}
+				default:
+					check(false);
+			}
+		}
+
+		const std::vector<SelData>* nodeInfo = nullptr;
+		if (in.get8())
+		{
+			std::vector<SelData> sels;
+			for (size_t i = in.getCount(); i > 0; --i)
+				sels.push_back(this->decodeSelData(in));
+
+			check(nullptr != typeBox);
+			nodeInfo = boxMan_.LookupTypeDesc(typeBox, sels);
+		}
+
+		return boxMan_.lookupLabel(node, nodeInfo);
+	}
+
+	std::shared_ptr<TreeAut> decodeTA(
+		Reader&                                 in,
+		const std::vector<label_type>&          labels)
+	{
+		std::shared_ptr<TreeAut> ta = std::shared_ptr<TreeAut>(new TreeAut(backend_));
+
+		for (size_t i = in.getCount(8); i > 0; --i)
+			ta->addFinalState(in.get64());
+
+		std::vector<size_t> lhs;
+		for (size_t i = in.getCount(); i > 0; --i)
+		{
+			const size_t label = in.get32();
+			check(label < labels.size());
+
+			lhs.clear();
+			for (size_t j = in.getCount(8); j > 0; --j)
+				lhs.push_back(in.get64());
+
+			ta->addTransition(lhs, labels[label], in.get64());
+		}
+
+		return ta;
+	}
+
+	static size_t getSelector(Reader& in)
+	{
+		const size_t sel = in.get64();
+		check(SelectorSet::isValid(sel));
+		return sel;
+	}
+
+	ConnectionGraph::CutpointSignature decodeSignature(Reader& in)
+	{
+		ConnectionGraph::CutpointSignature signature;
+		for (size_t i = in.getCount(); i > 0; --i)
+		{
+			ConnectionGraph::CutpointInfo cutpoint(in.get64());
+			cutpoint.refCount = in.get64();
+			cutpoint.selCount = in.get64();
+			cutpoint.refInherited = in.get8();
+			cutpoint.fwdSelectors.clear();
+			for (size_t j = in.getCount(8); j > 0; --j)
+				cutpoint.fwdSelectors.insert(getSelector(in));
+
+			check(!cutpoint.fwdSelectors.empty());
+			cutpoint.bwdSelector = in.get64();
+			for (size_t j = in.getCount(8); j > 0; --j)
+				cutpoint.defines.insert(getSelector(in));
+
+			signature.push_back(cutpoint);
+		}
+
+		return signature;
+	}
+
+	void decodeBox(Reader& in)
+	{
+		std::vector<label_type> labels;
+		for (size_t i = in.getCount(); i > 0; --i)
+			labels.push_back(this->decodeLabel(in));
+
+		std::shared_ptr<TreeAut> output = this->decodeTA(in, labels);
+		ConnectionGraph::CutpointSignature outputSignature = this->decodeSignature(in);
+
+		std::vector<size_t> inputMap;
+		for (size_t i = in.getCount(8); i > 0; --i)
+			inputMap.push_back(in.get64());
+
+		std::shared_ptr<TreeAut> input;
+		if (in.get8())
+			input = this->decodeTA(in, labels);
+
+		const size_t inputIndex = in.get64();
+		ConnectionGraph::CutpointSignature inputSignature = this->decodeSignature(in);
+
+		std::vector<std::pair<size_t, size_t>> selectors;
+		for (size_t i = in.getCount(16); i > 0; --i)
+		{
+			const size_t fwd = in.get64();
+			selectors.push_back(std::make_pair(fwd, in.get64()));
+		}
+
+		check(!output->getFinalStates().empty());
+		check(!input || (inputIndex < selectors.size()));
+
+		const Box box(
+			"",
+			output,
+			outputSignature,
+			inputMap,
+			input,
+			inputIndex,
+			inputSignature,
+			selectors
+		);
+
+		boxes_.push_back(boxMan_.insertBox(box));
+	}
+
+public:   // methods
+
+	BoxDecoder(BoxMan& boxMan, TreeAut::Backend& backend) :
+		boxMan_(boxMan),
+		backend_(backend),
+		boxes_{}
+	{ }
+
+	/**
+	 * @brief  Checks that all types of the signature exist in the box manager
+	 */
+	bool compatible(const std::string& key) const
+	{
+		Reader in(key);
+		for (size_t i = in.getCount(); i > 0; --i)
+		{
+			const TypeBox* typeBox = boxMan_.lookupTypeInfo(in.getString());
+
+			std::vector<size_t> sels;
+			for (size_t j = in.getCount(8); j > 0; --j)
+				sels.push_back(in.get64());
+
+			if ((nullptr == typeBox) || (typeBox->getSelectors() != sels))
+				return false;
+		}
+
+		return true;
+	}
+
+	void decode(const std::string& payload)
+	{
+		Reader in(payload);
+		for (size_t i = in.getCount(); i > 0; --i)
+			this->decodeBox(in);
+
+		check(in.atEnd());
+	}
+};
+
+} // namespace
+
+
+BoxDb::BoxDb(const std::string& root) :
+	fileName_(root + "/" + FILE_NAME),
+	foreign_{}
+{ }
+
+
+size_t BoxDb::load(BoxMan& boxMan, TreeAut::Backend& backend)
+{
+	foreign_.clear();
+
+	std::ifstream input(fileName_.c_str(), std::ios::binary);
+	if (!input)
+	{	// no database yet
+		FA_LOG("box database " << fileName_ << " not found");
+		return 0;
+	}
+
+	std::ostringstream contents;
+	contents << input.rdbuf();
+	const std::string buf = contents.str();
+
+	size_t loaded = 0;
+	try
+	{
+		Reader in(buf);
+		for (const char* c = MAGIC; c != MAGIC + sizeof(MAGIC); ++c)
+		{
+			if (in.get8() != static_cast<uint8_t>(*c))
+				throw std::runtime_error("not a box database");
+		}
+
+		const unsigned version = in.get32();
+		if (VERSION != version)
+		{
+			FA_WARN("ignoring box database " << fileName_ << " of version "
+				<< version << " (expected " << VERSION << ")");
+			return 0;
+		}
+
+		for (size_t i = in.getCount(); i > 0; --i)
+		{
+			Record record;
+			record.key = in.getString();
+			record.payload = in.getString();
+
+			BoxDecoder decoder(boxMan, backend);
+			if (!decoder.compatible(record.key))
+			{	// keep the record for other programs
+				foreign_.push_back(record);
+				continue;
+			}
+
+			decoder.decode(record.payload);
+			++loaded;
+		}
+	}
+	catch (const std::runtime_error& e)
+	{
+		FA_WARN("ignoring the rest of box database " << fileName_ << ": "
+			<< e.what());
+	}
+
+	FA_LOG("loaded " << loaded << " box(es) from " << fileName_);
+
+	return loaded;
+}
+
+
+size_t BoxDb::store(const BoxMan& boxMan)
+{
+	std::vector<const Box*> boxes;
+	boxMan.boxDatabase().asVector(boxes);
+
+	std::sort(boxes.begin(), boxes.end(),
+		[](const Box* b1, const Box* b2) { return b1->getName() < b2->getName(); });
+
+	std::set<std::pair<std::string, std::string>> seen;
+	std::vector<Record> records;
+	for (const Box* box : boxes)
+	{
+		try
+		{
+			Record record = BoxEncoder().encode(*box);
+			if (seen.insert(std::make_pair(record.key, record.payload)).second)
+				records.push_back(record);
+		}
+		catch (const UnsupportedBox&)
+		{
+			FA_LOG("not storing " << box->getName() << " into the box database");
+		}
+	}
+
+	const size_t stored = records.size();
+	for (const Record& record : foreign_)
+	{
+		if (seen.insert(std::make_pair(record.key, record.payload)).second)
+			records.push_back(record);
+	}
+
+	std::string buf(MAGIC, sizeof(MAGIC));
+	Writer out(buf);
+	out.put32(VERSION);
+	out.put32(static_cast<uint32_t>(records.size()));
+	for (const Record& record : records)
+	{
+		out.putString(record.key);
+		out.putString(record.payload);
+	}
+
+	// write a temporary file first so that a crash does not leave a broken db
+	const std::string tmpName = fileName_ + ".tmp";
+	std::ofstream output(tmpName.c_str(), std::ios::binary | std::ios::trunc);
+	output.write(buf.data(), buf.size());
+	output.close();
+
+	if (!output || (0 != std::rename(tmpName.c_str(), fileName_.c_str())))
+	{
+		FA_WARN("unable to write box database " << fileName_);
+		std::remove(tmpName.c_str());
+		return 0;
+	}
+
+	FA_LOG("stored " << stored << " box(es) into " << fileName_);
+
+	return stored;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOX_DB_H
+#define BOX_DB_H
+
+/**
+ * @file boxdb.hh
+ * BoxDb - persistent database of learnt boxes
+ */
+
+// Standard library headers
+#include <string>
+#include <vector>
+
+// Forester headers
+#include "treeaut_label.hh"
+
+class Box;
+class BoxMan;
+
+/**
+ * @brief  Persistent database of learnt boxes
+ *
+ * The database is a single binary file (@p boxes.fadb) in the database root
+ * directory. It starts with a magic string and the format version followed by
+ * a sequence of records. Each record describes one box together with all boxes
+ * nested in it and is keyed by the type signature of the box, i.e., the names
+ * and selector layouts of all types the box refers to.
+ *
+ * A record is loaded only if all types of its signature exist in the analysed
+ * program with the same layout. Records that cannot be loaded are kept and
+ * written back, so the database can be shared among related programs. A file
+ * with a different version is ignored (and overwritten on the next store).
+ */
+class BoxDb
+{
+public:   // data types
+
+	/// The version of the format, to be incremented on every change
+	static const unsigned VERSION = 1;
+
+	/// A record of the database (the type signature and the serialized boxes)
+	struct Record
+	{
+		std::string key;
+		std::string payload;
+
+		Record() :
+			key{},
+			payload{}
+		{ }
+	};
+
+private:  // data members
+
+	/// the name of the database file
+	std::string fileName_;
+
+	/// records read from the database that were not loaded
+	std::vector<Record> foreign_;
+
+public:   // methods
+
+	/**
+	 * @brief  Constructor
+	 *
+	 * @param[in]  root  The root directory of the database
+	 */
+	explicit BoxDb(const std::string& root);
+
+	/**
+	 * @brief  Loads boxes compatible with the program into the box manager
+	 *
+	 * @param[in,out]  boxMan   The box manager with the types of the program
+	 * @param[in]      backend  The backend for the tree automata of the boxes
+	 *
+	 * @returns  The number of loaded records
+	 */
+	size_t load(BoxMan& boxMan, TreeAut::Backend& backend);
+
+	/**
+	 * @brief  Stores all boxes of the box manager into the database
+	 *
+	 * Boxes containing native pointers (e.g. return addresses) are skipped.
+	 *
+	 * @param[in]  boxMan  The box manager
+	 *
+	 * @returns  The number of records written for boxes of @p boxMan
+	 */
+	size_t store(const BoxMan& boxMan);
+};
+
+#endif
@@ -197,6 +197,7 @@ label_type BoxMan::lookupLabel(
 	size_t                        arity,
 	const DataArray&              x)
 {
+	lock_type lock(mutex_);
 	std::pair<TVarDataStore::iterator, bool> p = vDataStore_.insert(
 		std::make_pair(std::make_pair(arity, x), static_cast<NodeLabel*>(nullptr)));
 	if (p.second)
@@ -248,6 +249,7 @@ label_type BoxMan::lookupLabel(
 	const std::vector<const AbstractBox*>&     x,
 	const std::vector<SelData>*                nodeInfo)
 {
+	lock_type lock(mutex_);
 	std::pair<TNodeStore::iterator, bool> p = nodeStore_.insert(
 		std::make_pair(x, static_cast<NodeLabel*>(nullptr)));
 
@@ -282,6 +284,7 @@ label_type BoxMan::lookupLabel(
 
 const SelBox* BoxMan::getSelector(const SelData& sel)
 {
+	lock_type lock(mutex_);
 	std::pair<const SelData, const SelBox*>& p = *selIndex_.insert(
 		std::make_pair(sel, static_cast<const SelBox*>(nullptr))
 	).first;
@@ -297,6 +300,7 @@ const SelBox* BoxMan::getSelector(const SelData& sel)
 
 const TypeBox* BoxMan::getTypeInfo(const std::string& name)
 {
+	lock_type lock(mutex_);
 	TTypeIndex::const_iterator i = typeIndex_.find(name);
 	if (i == typeIndex_.end())
 		throw std::runtime_error("BoxMan::getTypeInfo(): type for "
@@ -305,10 +309,19 @@ const TypeBox* BoxMan::getTypeInfo(const std::string& name)
 }
 
 
+const TypeBox* BoxMan::lookupTypeInfo(const std::string& name) const
+{
+	lock_type lock(mutex_);
+	TTypeIndex::const_iterator i = typeIndex_.find(name);
+	return (i == typeIndex_.end())? nullptr : i->second;
+}
+
+
 const TypeBox* BoxMan::createTypeInfo(
 	const std::string&            name,
 	const std::vector<size_t>&    selectors)
 {
+	lock_type lock(mutex_);
 	std::pair<const std::string, const TypeBox*>& p = *typeIndex_.insert(
 		std::make_pair(name, static_cast<const TypeBox*>(nullptr))).first;
 	if (p.second && (selectors != p.second->getSelectors()))
@@ -411,20 +424,43 @@ Box* BoxMan::createType2Box(
 }
 
 
-const Box* BoxMan::getBox(const Box& box)
+const Box* BoxMan::insertBox(const Box& box, bool& inserted)
 {
+	lock_type lock(mutex_);
+
 	// insert the box into the manager
 	const Box* cpBox = boxes_.get(box);
 	assert(nullptr != cpBox);
 
-	if (boxes_.modified())
+	inserted = boxes_.modified();
+	if (inserted)
 	{	// in the case a new box was inserted
 		Box* pBox = const_cast<Box*>(cpBox);
 
 		// perform initialization
 		pBox->name_ = this->getBoxName();
 		pBox->initialize();
+	}
+
+	return cpBox;
+}
+
+
+const Box* BoxMan::insertBox(const Box& box)
+{
+	bool inserted;
+	return this->insertBox(box, inserted);
+}
 
+
+const Box* BoxMan::getBox(const Box& box)
+{
+	// do not use boxes_.modified(), another thread may have changed it already
+	bool inserted;
+	const Box* cpBox = this->insertBox(box, inserted);
+
+	if (inserted)
+	{	// in the case a new box was inserted
 		FA_DEBUG_AT(1, "learning " << *static_cast<const AbstractBox*>(cpBox)
 			<< ':' << std::endl << *cpBox);
 
@@ -439,6 +475,7 @@ const Box* BoxMan::getBox(const Box& box)
 
 void BoxMan::clear()
 {
+	lock_type lock(mutex_);
 	utils::eraseMap(dataStore_);
 	dataIndex_.clear();
 	utils::eraseMap(nodeStore_);
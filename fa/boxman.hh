@@ -27,6 +27,7 @@
 
 // Forester headers
 #include "box.hh"
+#include "optional_mutex.hh"
 
 class BoxAntichain
 {
@@ -291,6 +292,9 @@ private:  // data members
 
 	TTypeDescDict typeDescDict_;
 
+	/// serializes the access of workers of the parallel execution
+	mutable OptionalMutex<std::recursive_mutex> mutex_;
+
 private:  // methods
 
 	const std::pair<const Data, NodeLabel*>& insertData(const Data& data);
@@ -306,10 +310,24 @@ private:  // methods
 	std::string getBoxName() const;
 
 
+	/**
+	 * @brief  Inserts a box into the database
+	 *
+	 * @param[in]   box       The box to be found (or inserted) in the database
+	 * @param[out]  inserted  Set to @p true if @p box was inserted
+	 *
+	 * @returns  Unique pointer to the box
+	 */
+	const Box* insertBox(const Box& box, bool& inserted);
+
+
 public:
 
+	typedef std::lock_guard<OptionalMutex<std::recursive_mutex>> lock_type;
+
 	label_type lookupLabel(const Data& data)
 	{
+		lock_type lock(mutex_);
 		return this->insertData(data).second;
 	}
 
@@ -319,6 +337,7 @@ public:
 		const TypeBox* tb,
 		const std::vector<SelData>& sels)
 	{
+		lock_type lock(mutex_);
 		auto itBoolPair = typeDescDict_.insert(std::make_pair(tb, sels));
 		if (!itBoolPair.second)
 		{	// in case a new element was not inserted
@@ -354,16 +373,20 @@ public:
 
 	const Data& getData(const Data& data)
 	{
+		lock_type lock(mutex_);
 		return this->insertData(data).first;
 	}
 
 	size_t getDataId(const Data& data)
 	{
+		lock_type lock(mutex_);
 		return this->insertData(data).second->getDataId();
 	}
 
 	const Data& getData(size_t index) const
 	{
+		lock_type lock(mutex_);
+
 		// Assertions
 		assert(index < dataIndex_.size());
 
@@ -374,6 +397,11 @@ public:
 
 	const TypeBox* getTypeInfo(const std::string& name);
 
+	/**
+	 * @brief  Retrieves the type of the given name (or @p nullptr if none)
+	 */
+	const TypeBox* lookupTypeInfo(const std::string& name) const;
+
 	const TypeBox* createTypeInfo(
 		const std::string&                           name,
 		const std::vector<size_t>&                   selectors);
@@ -448,11 +476,35 @@ public:
 	const Box* getBox(const Box& box);
 
 
+	/**
+	 * @brief  Inserts a box into the database without requesting a restart
+	 *
+	 * Same as getBox(), but the insertion of a new box is not reported by
+	 * RestartRequest. Used for boxes loaded from a persistent database.
+	 *
+	 * @param[in]  box  The box to be found (or inserted) in the database
+	 *
+	 * @returns  Unique pointer to the box
+	 */
+	const Box* insertBox(const Box& box);
+
+
 	const Box* lookupBox(const Box& box) const
 	{
+		lock_type lock(mutex_);
 		return boxes_.lookup(box);
 	}
 
+
+	/**
+	 * @brief  The number of (active) boxes in the database
+	 */
+	size_t boxCount() const
+	{
+		lock_type lock(mutex_);
+		return boxes_.size();
+	}
+
 	BoxMan() :
 		dataStore_{},
 		dataIndex_{},
@@ -462,7 +514,8 @@ public:
 		selIndex_{},
 		typeIndex_{},
 		boxes_{},
-		typeDescDict_{}
+		typeDescDict_{},
+		mutex_{}
 	{ }
 
 	~BoxMan()
@@ -472,6 +525,19 @@ public:
 
 	void clear();
 
+
+	/**
+	 * @brief  Allows the manager to be used by several threads
+	 *
+	 * In the concurrent mode, the lookup of labels, selectors, types and boxes
+	 * is serialized. The database of boxes returned by boxDatabase() must then
+	 * be accessed only when no other thread uses the manager.
+	 */
+	void setConcurrent(bool concurrent)
+	{
+		mutex_.enable(concurrent);
+	}
+
 	const BoxDatabase& boxDatabase() const
 	{
 		return boxes_;
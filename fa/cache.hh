@@ -25,18 +25,27 @@
 #include <list>
 #include <set>
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <unordered_map>
 
 // Boost headers
 #include <boost/functional/hash.hpp>
 
-template <class T>
+// Forester headers
+#include "optional_mutex.hh"
+
+template <class T,
+	class Allocator = std::allocator<std::pair<const T, size_t>>>
 class Cache
 {
 public:   // data types
 
-	typedef typename std::unordered_map<T, size_t, boost::hash<T>> store_type;
-	typedef typename std::unordered_map<T, size_t, boost::hash<T>>::value_type value_type;
+	typedef typename std::unordered_map<T, size_t, boost::hash<T>,
+		std::equal_to<T>, Allocator> store_type;
+	typedef typename store_type::value_type value_type;
+
+	typedef OptionalMutex<std::recursive_mutex> mutex_type;
 
 	struct Listener {
 		virtual void drop(value_type* x) = 0;
@@ -49,13 +58,27 @@ private:  // data members
 
 	std::vector<Listener*> listeners;
 
+	/// guards the store in the concurrent mode (listeners may use the cache)
+	mutex_type mutex;
+
 public:
 
 	Cache() :
 		store{},
-		listeners{}
+		listeners{},
+		mutex{}
 	{ }
 
+	/**
+	 * @brief  Switches the cache to the concurrent mode (or back)
+	 *
+	 * In the concurrent mode, all operations on the cache are serialized.
+	 */
+	void setConcurrent(bool concurrent)
+	{
+		this->mutex.enable(concurrent);
+	}
+
 	void addListener(Listener* x)
 	{
 		this->listeners.push_back(x);
@@ -63,22 +86,26 @@ public:
 
 	value_type* find(const T& x)
 	{
+		std::lock_guard<mutex_type> lock(this->mutex);
 		typename store_type::iterator i = this->store.find(x);
 		return (i == this->store.end())?(nullptr):(&*i);
 	}
 
 	value_type* lookup(const T& x)
 	{
+		std::lock_guard<mutex_type> lock(this->mutex);
 		return this->addRef(&*this->store.insert(std::make_pair(x, 0)).first);
 	}
 
 	value_type* addRef(value_type* x)
 	{
+		std::lock_guard<mutex_type> lock(this->mutex);
 		return ++x->second, x;
 	}
 
 	size_t release(value_type* x)
 	{
+		std::lock_guard<mutex_type> lock(this->mutex);
 		if (x->second > 1)
 			return --x->second;
 
@@ -91,6 +118,7 @@ public:
 
 	void clear()
 	{
+		std::lock_guard<mutex_type> lock(this->mutex);
 		for (Listener* lsnr : this->listeners)
 		{
 			for (typename store_type::iterator j = this->store.begin(); j != this->store.end(); ++j)
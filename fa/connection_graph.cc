@@ -42,13 +42,57 @@ void ConnectionGraph::updateStateSignature(
 
 			oldSig[i].refCount = std::max(oldSig[i].refCount, v[i].refCount);
 			oldSig[i].selCount = std::max(oldSig[i].selCount, v[i].selCount);
-			oldSig[i].fwdSelectors.insert(v[i].fwdSelectors.begin(),
-				v[i].fwdSelectors.end());
+			oldSig[i].fwdSelectors.insert(v[i].fwdSelectors);
 		}
 	}
 }
 
 
+std::shared_ptr<const ConnectionGraph::StateToCutpointSignatureMap>
+ConnectionGraph::SignatureCache::get(
+	const std::shared_ptr<const TreeAut>&     ta)
+{
+	// Preconditions
+	assert(nullptr != ta);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++queries_;
+
+		auto it = entries_.find(ta.get());
+		if ((entries_.end() != it) && (it->second.ta.lock() == ta))
+		{
+			++hits_;
+			return it->second.signatures;
+		}
+	}
+
+	std::shared_ptr<StateToCutpointSignatureMap> signatures(
+		new StateToCutpointSignatureMap());
+	ConnectionGraph::computeSignatures(*signatures, *ta);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (entries_.size() >= sweepAt_)
+	{	// remove the entries of freed automata
+		for (auto it = entries_.begin(); it != entries_.end(); )
+		{
+			if (it->second.ta.expired())
+				it = entries_.erase(it);
+			else
+				++it;
+		}
+
+		sweepAt_ = std::max(static_cast<size_t>(MIN_SWEEP), 2 * entries_.size());
+	}
+
+	Entry& entry = entries_[ta.get()];
+	entry.ta = ta;
+	entry.signatures = signatures;
+
+	return signatures;
+}
+
+
 void ConnectionGraph::computeSignatures(
 	StateToCutpointSignatureMap&     stateMap,
 	const TreeAut&                   ta)
@@ -527,8 +571,7 @@ void ConnectionGraph::normalizeSignature(CutpointSignature& signature)
 				static_cast<size_t>(FA_REF_CNT_TRESHOLD));
 			cutpoint.selCount = cutpoint.selCount + signature[i].selCount;
 			cutpoint.refInherited = false;
-			cutpoint.fwdSelectors.insert(
-					signature[i].fwdSelectors.begin(), signature[i].fwdSelectors.end());
+			cutpoint.fwdSelectors.insert(signature[i].fwdSelectors);
 
 			// fwdSelectors always contains -1 which we need to subtract
 			cutpoint.selCount = cutpoint.fwdSelectors.size() - 1;
@@ -541,8 +584,7 @@ void ConnectionGraph::normalizeSignature(CutpointSignature& signature)
 			assert(
 				ConnectionGraph::areDisjoint(cutpoint.defines, signature[i].defines));
 
-			cutpoint.defines.insert(
-				signature[i].defines.begin(), signature[i].defines.end());
+			cutpoint.defines.insert(signature[i].defines);
 		}
 	}
 
@@ -29,6 +29,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <cassert>
 
 // Forester headers
@@ -36,6 +37,7 @@
 #include "treeaut_label.hh"
 #include "abstractbox.hh"
 #include "config.h"
+#include "selectorset.hh"
 
 
 #define _MSBM         ((~static_cast<size_t>(0)) >> 1)
@@ -68,7 +70,7 @@ public:
 		bool refInherited;
 
 		/// a set of selectors which reach the given cutpoint
-		std::set<size_t> fwdSelectors;
+		SelectorSet fwdSelectors;
 
 		/// lowest selector of 'root' from which the state can be reached in the
 		/// opposite direction
@@ -76,7 +78,7 @@ public:
 
 		/// set of selectors of the cutpoint hidden in the subtree (includes
 		/// backwardSelector if exists)
-		std::set<size_t> defines;
+		SelectorSet defines;
 
 		CutpointInfo(size_t root = 0) :
 			root(root),
@@ -262,18 +264,15 @@ public:
 	}
 
 	static bool areDisjoint(
-		const std::set<size_t>&    s1,
-		const std::set<size_t>&    s2)
+		const SelectorSet&    s1,
+		const SelectorSet&    s2)
 	{
-		std::vector<size_t> v(s1.size());
-
-		return std::set_intersection(s1.begin(), s1.end(),
-			s2.begin(), s2.end(), v.begin()) == v.begin();
+		return s1.isDisjoint(s2);
 	}
 
-	static bool isSubset(const std::set<size_t>& s1, const std::set<size_t>& s2)
+	static bool isSubset(const SelectorSet& s1, const SelectorSet& s2)
 	{
-		return std::includes(s1.begin(), s1.end(), s2.begin(), s2.end());
+		return s1.includes(s2);
 	}
 
 
@@ -358,6 +357,84 @@ public:
 		StateToCutpointSignatureMap&    stateMap,
 		const TreeAut&                  ta);
 
+	/**
+	 * @brief  Signatures of the states of tree automata, memoized per automaton
+	 *
+	 * The cache is keyed by the identity of the automaton. A tree automaton is
+	 * never modified once it is a component of a forest automaton (a modified
+	 * component is replaced by a new automaton, see FAE::setRoot()), so its
+	 * signatures stay valid as long as it lives and need not be recomputed in
+	 * every folding round. Every entry keeps a weak pointer to its automaton,
+	 * so that a new automaton allocated at the address of a freed one is not
+	 * mistaken for it; entries of freed automata are swept out from time to
+	 * time.
+	 */
+	class SignatureCache
+	{
+	private:  // data types
+
+		struct Entry
+		{
+			std::weak_ptr<const TreeAut> ta;
+			std::shared_ptr<const StateToCutpointSignatureMap> signatures;
+
+			Entry() :
+				ta{},
+				signatures{}
+			{ }
+		};
+
+		/// the minimal number of entries at which freed automata are swept out
+		static const size_t MIN_SWEEP = 1024;
+
+	private:  // data members
+
+		std::unordered_map<const TreeAut*, Entry> entries_;
+
+		/// the number of entries at which the next sweep happens
+		size_t sweepAt_;
+
+		size_t queries_;
+		size_t hits_;
+
+		/// the cache is shared by all threads, signatures are computed unlocked
+		mutable std::mutex mutex_;
+
+	public:   // methods
+
+		SignatureCache() :
+			entries_{},
+			sweepAt_(MIN_SWEEP),
+			queries_(0),
+			hits_(0),
+			mutex_{}
+		{ }
+
+		/**
+		 * @brief  Returns the signatures of the states of @p ta
+		 */
+		std::shared_ptr<const StateToCutpointSignatureMap> get(
+			const std::shared_ptr<const TreeAut>&    ta);
+
+		size_t queries() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return queries_;
+		}
+
+		size_t hits() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return hits_;
+		}
+	};
+
+	static SignatureCache& signatureCache()
+	{
+		static SignatureCache cache;
+		return cache;
+	}
+
 	// TODO: I don't know what this method does
 	// (computes signature for all states of ta) ???
 	static void fixSignatures(
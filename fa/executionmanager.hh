@@ -21,26 +21,54 @@
 #define EXECUTION_MANAGER_H
 
 // Standard library headers
-#include <list>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // Forester headers
 #include "types.hh"
 #include "recycler.hh"
 #include "abstractinstruction.hh"
+#include "explorationstrategy.hh"
 #include "fixpointinstruction.hh"
+#include "optional_mutex.hh"
 #include "symstate.hh"
 
 
 /**
  * @brief  Class that carries out symbolic execution of the code
  *
- * This class performs symbolic execution of the code.
+ * This class performs symbolic execution of the code. By default, states are
+ * processed by a single thread from a single queue, in the order given by the
+ * exploration strategy (DFS unless set by setStrategy()). After startWorkers()
+ * is called, each worker has its own deque of states: a worker pushes the
+ * successors of its states to the back of its deque and pops from the back
+ * (i.e., it explores the state space in the DFS order regardless of the
+ * strategy), and an idle worker steals the oldest states from the front of the
+ * deques of other workers.
  */
 class ExecutionManager
 {
 private:  // data types
 
-	typedef std::list<SymState*> QueueType;
+	typedef OptionalMutex<std::recursive_mutex> TreeMutex;
+
+	typedef std::lock_guard<TreeMutex> TreeLock;
+
+	/// the deque of states of a worker
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<SymState*> states;
+
+		WorkerQueue() :
+			mutex{},
+			states{}
+		{ }
+	};
 
 private:  // data members
 
@@ -48,13 +76,25 @@ private:  // data members
 	SymState* root_;
 
 	/// the queue with the states to be processed
-	QueueType queue_;
+	std::unique_ptr<ExplorationStrategy> queue_;
+
+	/// the maximal number of states in the queue
+	size_t maxQueueSize_;
 
 	/// counter of evaluated states
-	size_t statesExecuted_;
+	std::atomic<size_t> statesExecuted_;
 
 	/// counter of evaluated paths
-	size_t pathsEvaluated_;
+	std::atomic<size_t> pathsEvaluated_;
+
+	/// deques of the workers (empty if running sequentially)
+	std::vector<std::unique_ptr<WorkerQueue>> workers_;
+
+	/// the number of states queued or being executed by the workers
+	std::atomic<size_t> pending_;
+
+	/// guards the execution graph when running in parallel
+	TreeMutex treeMutex_;
 
 	/// memory manager for registers
 	Recycler<DataArray> registerRecycler_;
@@ -84,13 +124,40 @@ private:  // methods
 	ExecutionManager(const ExecutionManager&);
 	ExecutionManager& operator=(const ExecutionManager&);
 
+	/**
+	 * @brief  The index of the worker run by the current thread
+	 */
+	static size_t& currentWorker()
+	{
+		static thread_local size_t worker = 0;
+		return worker;
+	}
+
+	/**
+	 * @brief  Steals a state from the front of the deque of a worker
+	 */
+	SymState* steal(WorkerQueue& victim)
+	{
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (victim.states.empty())
+			return nullptr;
+
+		SymState* state = victim.states.front();
+		victim.states.pop_front();
+		return state;
+	}
+
 public:
 
 	ExecutionManager() :
 		root_(nullptr),
-		queue_{},
-		statesExecuted_{},
-		pathsEvaluated_{},
+		queue_(ExplorationStrategy::create("dfs")),
+		maxQueueSize_{0},
+		statesExecuted_{0},
+		pathsEvaluated_{0},
+		workers_{},
+		pending_{0},
+		treeMutex_{},
 		registerRecycler_{},
 		stateRecycler_{}
 	{ }
@@ -106,13 +173,19 @@ public:
 
 	void clear()
 	{
+		TreeLock lock(treeMutex_);
 		if (nullptr != root_)
 		{
 			root_->recycle(stateRecycler_);
 			root_ = nullptr;
 		}
 
-		queue_.clear();
+		queue_->clear();
+		maxQueueSize_ = 0;
+		for (std::unique_ptr<WorkerQueue>& worker : workers_)
+			worker->states.clear();
+
+		pending_ = 0;
 
 		statesExecuted_ = 0;
 		pathsEvaluated_ = 0;
@@ -131,6 +204,8 @@ public:
 		AbstractInstruction*               instr)
 	{
 		SymState* state = createState();
+
+		TreeLock lock(treeMutex_);
 		state->initChildFrom(&oldState, instr);
 
 		return state;
@@ -142,6 +217,8 @@ public:
 	{
 		SymState* state = createState();
 		const std::shared_ptr<DataArray> regs = allocRegisters(oldState.GetRegs());
+
+		TreeLock lock(treeMutex_);
 		state->initChildFrom(&oldState, instr, regs);
 
 		return state;
@@ -151,6 +228,8 @@ public:
 		const SymState&                    oldState)
 	{
 		SymState* state = createState();
+
+		TreeLock lock(treeMutex_);
 		state->init(oldState);
 
 		return state;
@@ -161,6 +240,8 @@ public:
 	{
 		SymState* state = createState();
 		const std::shared_ptr<DataArray> regs = allocRegisters(oldState.GetRegs());
+
+		TreeLock lock(treeMutex_);
 		state->init(oldState, regs);
 
 		return state;
@@ -172,6 +253,8 @@ public:
 	{
 		SymState* state = createState();
 		const std::shared_ptr<DataArray> regs = allocRegisters(oldState.GetRegs());
+
+		TreeLock lock(treeMutex_);
 		state->init(oldState, regs, const_cast<AbstractInstruction*>(insn));
 
 		return state;
@@ -185,10 +268,12 @@ public:
 	{
 		SymState* state = createState();
 
-		state->init(parent, instr, fae, registers);
-		queue_.push_back(state);
+		{
+			TreeLock lock(treeMutex_);
+			state->init(parent, instr, fae, registers);
+		}
 
-		return state;
+		return this->enqueue(state);
 	}
 
 	SymState* enqueue(
@@ -197,34 +282,172 @@ public:
 		// Assertions
 		assert(nullptr != state);
 
-		queue_.push_back(state);
+		if (workers_.empty())
+		{
+			queue_->push(state);
+			if (queue_->size() > maxQueueSize_)
+				maxQueueSize_ = queue_->size();
+
+			return state;
+		}
+
+		// Assertions
+		assert(currentWorker() < workers_.size());
+
+		WorkerQueue& worker = *workers_[currentWorker()];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.states.push_back(state);
+		++pending_;
+
 		return state;
 	}
 
-	SymState* dequeueBFS()
+	/**
+	 * @brief  Retrieves the next state to be processed (sequential mode)
+	 *
+	 * @returns  The next state according to the exploration strategy or
+	 *           @p nullptr if there are no states left
+	 */
+	SymState* dequeue()
 	{
-		if (queue_.empty())
-			return nullptr;
+		return queue_->pop();
+	}
 
-		SymState* state = queue_.front();
-		assert(nullptr != state);
+	/**
+	 * @brief  Sets the exploration strategy
+	 *
+	 * May be called only when the queue is empty.
+	 *
+	 * @param[in]  name  The name of the strategy (see ExplorationStrategy)
+	 */
+	void setStrategy(const std::string& name)
+	{
+		// Assertions
+		assert(queue_->empty());
+
+		queue_ = ExplorationStrategy::create(name);
+	}
 
-		queue_.pop_front();
+	const char* strategyName() const { return queue_->name(); }
 
-		return state;
+	size_t maxQueueSize() const { return maxQueueSize_; }
+
+	/**
+	 * @brief  Switches to the parallel mode with @p count workers
+	 *
+	 * The states in the queue are distributed among the workers. Each worker
+	 * thread needs to call setWorker() with its index before it dequeues any
+	 * states.
+	 *
+	 * @param[in]  count  The number of workers
+	 */
+	void startWorkers(size_t count)
+	{
+		// Assertions
+		assert(count > 0);
+		assert(workers_.empty());
+
+		treeMutex_.enable(true);
+
+		for (size_t i = 0; i < count; ++i)
+			workers_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
+		// the state to be processed next goes to the back of the first worker
+		std::vector<SymState*> states;
+		queue_->drain(states);
+		for (size_t i = 0; i < states.size(); ++i)
+			workers_[i % count]->states.push_front(states[i]);
+
+		pending_ = states.size();
 	}
 
-	SymState* dequeueDFS()
+	/**
+	 * @brief  Switches back to the sequential mode
+	 *
+	 * The states left in the deques of the workers (e.g. after an error) are
+	 * moved back to the queue. May be called only after all workers finished.
+	 */
+	void stopWorkers()
 	{
-		if (queue_.empty())
-			return nullptr;
+		for (std::unique_ptr<WorkerQueue>& worker : workers_)
+		{
+			for (SymState* state : worker->states)
+				queue_->push(state);
+		}
 
-		SymState* state = queue_.back();
-		assert(nullptr != state);
+		workers_.clear();
+		pending_ = 0;
 
-		queue_.pop_back();
+		treeMutex_.enable(false);
+	}
 
-		return state;
+	/**
+	 * @brief  Checks whether the states are executed by several workers
+	 */
+	bool parallel() const { return !workers_.empty(); }
+
+	/**
+	 * @brief  Sets the index of the worker run by the calling thread
+	 */
+	void setWorker(size_t worker)
+	{
+		currentWorker() = worker;
+	}
+
+	/**
+	 * @brief  Retrieves a state for the given worker
+	 *
+	 * Pops the most recent state of the worker or, if there is none, steals the
+	 * oldest state of another worker. Waits while other workers are executing
+	 * states (which may produce new ones).
+	 *
+	 * @param[in]  worker  Index of the worker
+	 * @param[in]  stop    Flag requesting the termination of all workers
+	 *
+	 * @returns  The state to be executed, or @p nullptr if there are no states
+	 *           left or @p stop is set; the caller needs to call stateDone()
+	 *           after the state has been executed
+	 */
+	SymState* dequeue(size_t worker, const std::atomic<bool>& stop)
+	{
+		// Assertions
+		assert(worker < workers_.size());
+
+		while (!stop && pending_)
+		{
+			{
+				WorkerQueue& own = *workers_[worker];
+				std::lock_guard<std::mutex> lock(own.mutex);
+				if (!own.states.empty())
+				{
+					SymState* state = own.states.back();
+					own.states.pop_back();
+					return state;
+				}
+			}
+
+			for (size_t i = 1; i < workers_.size(); ++i)
+			{
+				SymState* state = this->steal(*workers_[(worker + i) % workers_.size()]);
+				if (nullptr != state)
+					return state;
+			}
+
+			std::this_thread::yield();
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * @brief  Notifies that a state obtained from dequeue() has been executed
+	 */
+	void stateDone()
+	{
+		// Assertions
+		assert(pending_ > 0);
+
+		--pending_;
 	}
 
 	std::shared_ptr<DataArray> allocRegisters(const DataArray& model)
@@ -237,6 +460,16 @@ public:
 		return std::shared_ptr<DataArray>(v, RecycleRegisterF(registerRecycler_));
 	}
 
+	/**
+	 * @brief  The recycler of states (for statistics)
+	 */
+	const Recycler<SymState>& stateRecycler() const { return stateRecycler_; }
+
+	/**
+	 * @brief  The recycler of register files (for statistics)
+	 */
+	const Recycler<DataArray>& registerRecycler() const { return registerRecycler_; }
+
 	void init(const DataArray& registers, const std::shared_ptr<const FAE>& fae,
 		AbstractInstruction* instr)
 	{
@@ -274,6 +507,7 @@ public:
 		// Assertions
 		assert(nullptr != state);
 
+		TreeLock lock(treeMutex_);
 		state->recycle(stateRecycler_);
 	}
 
@@ -283,6 +517,8 @@ public:
 		// Assertions
 		assert(nullptr != state);
 
+		TreeLock lock(treeMutex_);
+
 		while (state->GetParent())
 		{
 			// Assertions
@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Standard library headers
+#include <deque>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Forester headers
+#include "abstractinstruction.hh"
+#include "explorationstrategy.hh"
+#include "forestaut.hh"
+#include "symstate.hh"
+
+namespace
+{	// anonymous namespace
+
+/// the most recent state first
+class DFS : public ExplorationStrategy
+{
+protected:// data members
+
+	std::vector<SymState*> stack_;
+
+public:   // methods
+
+	DFS() :
+		stack_{}
+	{ }
+
+	virtual const char* name() const
+	{
+		return "dfs";
+	}
+
+	virtual void push(SymState* state)
+	{
+		stack_.push_back(state);
+	}
+
+	virtual SymState* pop()
+	{
+		if (stack_.empty())
+			return nullptr;
+
+		SymState* state = stack_.back();
+		stack_.pop_back();
+		return state;
+	}
+
+	virtual size_t size() const
+	{
+		return stack_.size();
+	}
+
+	virtual void clear()
+	{
+		stack_.clear();
+	}
+};
+
+
+/// the oldest state first
+class BFS : public ExplorationStrategy
+{
+private:  // data members
+
+	std::deque<SymState*> queue_;
+
+public:   // methods
+
+	BFS() :
+		queue_{}
+	{ }
+
+	virtual const char* name() const
+	{
+		return "bfs";
+	}
+
+	virtual void push(SymState* state)
+	{
+		queue_.push_back(state);
+	}
+
+	virtual SymState* pop()
+	{
+		if (queue_.empty())
+			return nullptr;
+
+		SymState* state = queue_.front();
+		queue_.pop_front();
+		return state;
+	}
+
+	virtual size_t size() const
+	{
+		return queue_.size();
+	}
+
+	virtual void clear()
+	{
+		queue_.clear();
+	}
+};
+
+
+/// the state with the smallest forest automaton first
+class Smallest : public ExplorationStrategy
+{
+private:  // data types
+
+	/// (size of the FA, insertion order, state)
+	typedef std::pair<std::pair<size_t, size_t>, SymState*> Item;
+
+	/// orders the smallest size and then the highest insertion order first
+	struct ItemCompare
+	{
+		bool operator()(const Item& lhs, const Item& rhs) const
+		{
+			if (lhs.first.first != rhs.first.first)
+				return lhs.first.first > rhs.first.first;
+
+			return lhs.first.second < rhs.first.second;
+		}
+	};
+
+private:  // data members
+
+	std::priority_queue<Item, std::vector<Item>, ItemCompare> queue_;
+
+	size_t counter_;
+
+	/**
+	 * @brief  The size of the forest automaton of the state
+	 *
+	 * The number of transitions of all components (plus the number of
+	 * components, so that empty components are counted as well).
+	 */
+	static size_t faeSize(const SymState& state)
+	{
+		const std::shared_ptr<const FAE> fae = state.GetFAE();
+		if (!fae)
+			return 0;
+
+		size_t size = fae->getRootCount();
+		for (size_t i = 0; i < fae->getRootCount(); ++i)
+		{
+			if (fae->getRoot(i))
+				size += fae->getRoot(i)->getTransitions().size();
+		}
+
+		return size;
+	}
+
+public:   // methods
+
+	Smallest() :
+		queue_{},
+		counter_{0}
+	{ }
+
+	virtual const char* name() const
+	{
+		return "smallest";
+	}
+
+	virtual void push(SymState* state)
+	{
+		queue_.push(Item(std::make_pair(faeSize(*state), counter_++), state));
+	}
+
+	virtual SymState* pop()
+	{
+		if (queue_.empty())
+			return nullptr;
+
+		SymState* state = queue_.top().second;
+		queue_.pop();
+		return state;
+	}
+
+	virtual size_t size() const
+	{
+		return queue_.size();
+	}
+
+	virtual void clear()
+	{
+		queue_ = std::priority_queue<Item, std::vector<Item>, ItemCompare>();
+		counter_ = 0;
+	}
+};
+
+
+/// DFS, but states at loop heads are postponed until nothing else is left
+class Loop : public DFS
+{
+private:  // data members
+
+	/// states entering a fixpoint computation point
+	std::vector<SymState*> heads_;
+
+public:   // methods
+
+	Loop() :
+		DFS{},
+		heads_{}
+	{ }
+
+	virtual const char* name() const
+	{
+		return "loop";
+	}
+
+	virtual void push(SymState* state)
+	{
+		if (fi_type_e::fiFix == state->GetInstr()->getType())
+			heads_.push_back(state);
+		else
+			stack_.push_back(state);
+	}
+
+	virtual SymState* pop()
+	{
+		if (!stack_.empty())
+			return DFS::pop();
+
+		if (heads_.empty())
+			return nullptr;
+
+		SymState* state = heads_.back();
+		heads_.pop_back();
+		return state;
+	}
+
+	virtual size_t size() const
+	{
+		return stack_.size() + heads_.size();
+	}
+
+	virtual void clear()
+	{
+		DFS::clear();
+		heads_.clear();
+	}
+};
+
+
+/// DFS, restarted from a random queued state every PERIOD states
+class RandomRestart : public DFS
+{
+private:  // data members
+
+	static const size_t PERIOD = 128;
+
+	/// the seed is fixed so that runs are reproducible
+	static const unsigned SEED = 42;
+
+	std::mt19937 random_;
+
+	size_t popped_;
+
+public:   // methods
+
+	RandomRestart() :
+		DFS{},
+		random_(SEED),
+		popped_{0}
+	{ }
+
+	virtual const char* name() const
+	{
+		return "random";
+	}
+
+	virtual SymState* pop()
+	{
+		if ((++popped_ % PERIOD == 0) && (stack_.size() > 1))
+		{	// move a random state to the top of the stack
+			std::uniform_int_distribution<size_t> dist(0, stack_.size() - 1);
+			std::swap(stack_[dist(random_)], stack_.back());
+		}
+
+		return DFS::pop();
+	}
+
+	virtual void clear()
+	{
+		DFS::clear();
+		random_.seed(SEED);
+		popped_ = 0;
+	}
+};
+
+} // namespace
+
+
+std::unique_ptr<ExplorationStrategy> ExplorationStrategy::create(
+	const std::string&             name)
+{
+	if ("dfs" == name)
+		return std::unique_ptr<ExplorationStrategy>(new DFS());
+
+	if ("bfs" == name)
+		return std::unique_ptr<ExplorationStrategy>(new BFS());
+
+	if ("smallest" == name)
+		return std::unique_ptr<ExplorationStrategy>(new Smallest());
+
+	if ("loop" == name)
+		return std::unique_ptr<ExplorationStrategy>(new Loop());
+
+	if ("random" == name)
+		return std::unique_ptr<ExplorationStrategy>(new RandomRestart());
+
+	throw std::invalid_argument("unknown exploration strategy \"" + name
+		+ "\" (use " + names() + ")");
+}
+
+
+const char* ExplorationStrategy::names()
+{
+	return "dfs|bfs|smallest|loop|random";
+}
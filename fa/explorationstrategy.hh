@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXPLORATION_STRATEGY_H
+#define EXPLORATION_STRATEGY_H
+
+/**
+ * @file explorationstrategy.hh
+ * ExplorationStrategy - the order in which symbolic states are processed
+ */
+
+// Standard library headers
+#include <memory>
+#include <string>
+#include <vector>
+
+class SymState;
+
+/**
+ * @brief  The queue of states waiting for execution
+ *
+ * An exploration strategy decides which of the queued states is executed next.
+ * The following strategies are available (see create()):
+ *
+ *  - @p dfs       the most recent state first (the default),
+ *  - @p bfs       the oldest state first,
+ *  - @p smallest  the state with the smallest forest automaton first (so that
+ *                 fixpoints are built from small configurations and stabilize
+ *                 early), the most recent one among states of equal size,
+ *  - @p loop      in the DFS order, but states entering a fixpoint computation
+ *                 point (a loop head) are postponed until no other state is
+ *                 left,
+ *  - @p random    in the DFS order, but every 128 states the search restarts
+ *                 from a randomly chosen queued state (with a fixed seed, so
+ *                 runs are reproducible).
+ */
+class ExplorationStrategy
+{
+public:   // methods
+
+	virtual ~ExplorationStrategy()
+	{ }
+
+	/**
+	 * @brief  The name of the strategy (as accepted by create())
+	 */
+	virtual const char* name() const = 0;
+
+	/**
+	 * @brief  Inserts a state into the queue
+	 */
+	virtual void push(SymState* state) = 0;
+
+	/**
+	 * @brief  Removes the state to be executed next from the queue
+	 *
+	 * @returns  The state to be executed next or @p nullptr if the queue is
+	 *           empty
+	 */
+	virtual SymState* pop() = 0;
+
+	/**
+	 * @brief  The number of queued states
+	 */
+	virtual size_t size() const = 0;
+
+	bool empty() const
+	{
+		return 0 == this->size();
+	}
+
+	/**
+	 * @brief  Removes all states from the queue
+	 */
+	virtual void clear() = 0;
+
+	/**
+	 * @brief  Removes all states from the queue, in the order of pop()
+	 *
+	 * @param[out]  states  The vector the states are appended to
+	 */
+	void drain(std::vector<SymState*>& states)
+	{
+		while (SymState* state = this->pop())
+			states.push_back(state);
+	}
+
+	/**
+	 * @brief  Creates the strategy of the given name
+	 *
+	 * @param[in]  name  The name of the strategy
+	 *
+	 * @returns  The new strategy
+	 *
+	 * @throws  std::invalid_argument  if there is no such strategy
+	 */
+	static std::unique_ptr<ExplorationStrategy> create(const std::string& name);
+
+	/**
+	 * @brief  Names of all strategies, separated by '|'
+	 */
+	static const char* names();
+};
+
+#endif
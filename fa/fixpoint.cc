@@ -289,7 +289,8 @@ void reorder(
 bool testInclusion(
 	FAE&                           fae,
 	TreeAut&                       fwdConf,
-	UFAE&                          fwdConfWrapper)
+	UFAE&                          fwdConfWrapper,
+	TreeAut::SimulationCache&      fwdConfSim)
 {
 	TreeAut ta(*fwdConf.backend);
 
@@ -306,7 +307,7 @@ bool testInclusion(
 
 	ta.clear();
 
-	fwdConf.minimized(ta);
+	fwdConf.minimized(ta, &fwdConfSim);
 	fwdConf = ta;
 
 	return false;
@@ -409,6 +410,72 @@ SymState* FixpointBase::reverseAndIsect(
 }
 
 
+bool FixpointBase::refold()
+{
+	if (!boxMan_.boxCount())
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	bool changed = false;
+	for (std::shared_ptr<const FAE>& conf : fwdConfFAEs_)
+	{
+		std::shared_ptr<FAE> fae = std::shared_ptr<FAE>(new FAE(*conf));
+
+		fae->updateConnectionGraph();
+
+		reorder(nullptr, *fae);
+
+		std::set<size_t> forbidden;
+		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
+		{
+			forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+		}
+
+		if (!fold(*fae, boxMan_, forbidden))
+		{	// the current boxes do not change the configuration
+			continue;
+		}
+
+		do
+		{
+			forbidden = Normalization::computeForbiddenSet(*fae);
+
+			normalize(*fae, nullptr, forbidden, true);
+
+			forbidden.clear();
+
+			for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
+			{
+				forbidden.insert(VirtualMachine(*fae).varGet(i).d_ref.root);
+			}
+		} while (fold(*fae, boxMan_, forbidden));
+
+		conf = fae;
+		changed = true;
+	}
+
+	if (!changed)
+		return false;
+
+	// rebuild the fixpoint from the folded configurations
+	fwdConf_.clear();
+	fwdConfWrapper_.clear();
+	fwdConfSim_.clear();
+
+	for (const std::shared_ptr<const FAE>& conf : fwdConfFAEs_)
+	{
+		FAE fae(*conf);
+
+		testInclusion(fae, fwdConf_, fwdConfWrapper_, fwdConfSim_);
+	}
+
+	FA_DEBUG_AT(1, "re-folded fixpoint" << std::endl << fwdConf_);
+
+	return true;
+}
+
+
 void FI_abs::abstract(
 	FAE&                 fae)
 {
@@ -423,15 +490,18 @@ void FI_abs::abstract(
 
 		ContainerGuard<std::vector<FAE*>> g(tmp);
 
-		FAE::loadCompatibleFAs(
-			/* the result */ tmp,
-			fwdConf_,
-			taBackend_,
-			boxMan_,
-			fae,
-			0,
-			CompareVariablesF()
-		);
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			FAE::loadCompatibleFAs(
+				/* the result */ tmp,
+				fwdConf_,
+				taBackend_,
+				boxMan_,
+				fae,
+				0,
+				CompareVariablesF()
+			);
+		}
 
 		for (size_t i = 0; i < tmp.size(); ++i)
 		{
@@ -485,7 +555,7 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 	// reorder components into the canonical form (no merging!)
 	reorder(&state, *fae);
 
-	if (!boxMan_.boxDatabase().empty())
+	if (boxMan_.boxCount())
 	{	// in the case there are some boxes, try to fold immediately before
 		// normalization
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
@@ -507,7 +577,7 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 #if FA_ALLOW_FOLDING
 	learn1(*fae, boxMan_);
 
-	if (boxMan_.boxDatabase().size())
+	if (boxMan_.boxCount())
 	{
 		FAE old(*fae->backend, boxMan_);
 
@@ -532,7 +602,18 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 	}
 #endif
 	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
+	bool hit;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		hit = testInclusion(*fae, fwdConf_, fwdConfWrapper_, fwdConfSim_);
+		if (!hit)
+		{	// configurations of fixpoints share equal components
+			fae->internRoots();
+			fwdConfFAEs_.push_back(fae);
+		}
+	}
+
+	if (hit)
 	{
 		FA_DEBUG_AT(3, "hit");
 
@@ -559,7 +640,7 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 #if FA_ALLOW_FOLDING
 	reorder(&state, *fae);
 
-	if (!boxMan_.boxDatabase().size())
+	if (!boxMan_.boxCount())
 	{
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 		{
@@ -573,7 +654,7 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 
 	normalize(*fae, &state, forbidden, true);
 #if FA_ALLOW_FOLDING
-	if (boxMan_.boxDatabase().size())
+	if (boxMan_.boxCount())
 	{
 		forbidden.clear();
 
@@ -598,7 +679,18 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 	}
 #endif
 	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
+	bool hit;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		hit = testInclusion(*fae, fwdConf_, fwdConfWrapper_, fwdConfSim_);
+		if (!hit)
+		{	// configurations of fixpoints share equal components
+			fae->internRoots();
+			fwdConfFAEs_.push_back(fae);
+		}
+	}
+
+	if (hit)
 	{
 		FA_DEBUG_AT(3, "hit");
 
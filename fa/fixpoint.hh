@@ -23,6 +23,7 @@
 // Standard library headers
 #include <vector>
 #include <memory>
+#include <mutex>
 
 // Forester headers
 #include "boxman.hh"
@@ -42,24 +43,37 @@ protected:
 
 	UFAE fwdConfWrapper_;
 
+	/// Simulation on the last minimized fixpoint configuration
+	TreeAut::SimulationCache fwdConfSim_;
+
+	/// Configurations joined into the fixpoint (kept for re-folding)
+	std::vector<std::shared_ptr<const FAE>> fwdConfFAEs_;
+
 	std::vector<std::shared_ptr<const FAE>> fixpoint_;
 
 	TreeAut::Backend& taBackend_;
 
 	BoxMan& boxMan_;
 
+	/// guards the fixpoint, which is shared by workers of the parallel execution
+	std::mutex mutex_;
+
 public:
 
 	virtual void extendFixpoint(const std::shared_ptr<const FAE>& fae)
 	{
+		std::lock_guard<std::mutex> lock(mutex_);
 		fixpoint_.push_back(fae);
 	}
 
 	virtual void clear()
 	{
+		std::lock_guard<std::mutex> lock(mutex_);
 		fixpoint_.clear();
 		fwdConf_.clear();
 		fwdConfWrapper_.clear();
+		fwdConfSim_.clear();
+		fwdConfFAEs_.clear();
 	}
 
 #if 0
@@ -93,9 +107,12 @@ public:
 		FixpointInstruction(insn),
 		fwdConf_(fixpointBackend),
 		fwdConfWrapper_(fwdConf_, boxMan),
+		fwdConfSim_{},
+		fwdConfFAEs_{},
 		fixpoint_{},
 		taBackend_(taBackend),
-		boxMan_(boxMan)
+		boxMan_(boxMan),
+		mutex_{}
 	{ }
 
 	virtual ~FixpointBase()
@@ -106,6 +123,18 @@ public:
 		return fwdConf_;
 	}
 
+	/**
+	 * @brief  Folds the configurations of the fixpoint using current boxes
+	 *
+	 * Used when a new box has been learnt and the analysis is resumed instead
+	 * of being restarted. If some configuration joined into the fixpoint can be
+	 * folded, the fixpoint is rebuilt from the folded configurations (which
+	 * represent the same heaps).
+	 *
+	 * @returns  @p true if the fixpoint has changed, @p false otherwise
+	 */
+	virtual bool refold();
+
 	virtual SymState* reverseAndIsect(
 		ExecutionManager&                      execMan,
 		const SymState&                        fwdPred,
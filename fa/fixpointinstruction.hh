@@ -39,6 +39,9 @@ public:
 
 	virtual const TreeAut& getFixPoint() const = 0;
 
+	/// re-folds the fixpoint with the current boxes, returns true if it changed
+	virtual bool refold() = 0;
+
 };
 
 #endif
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLAT_TREE_AUT_H
+#define FLAT_TREE_AUT_H
+
+// Standard library headers
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+template <class T> class TA;
+
+/**
+ * @brief  Flat read-only view of the transitions of a tree automaton
+ *
+ * The transitions of a TA are copied into contiguous arrays sorted by
+ * (rhs, label, lhs).  Left-hand sides are stored in a single array
+ * (struct-of-arrays layout), and states are renamed to a dense range
+ * <0, stateCount()).  Two CSR indices are prebuilt:
+ *  - top-down: transitions with the given state on the right-hand side,
+ *  - bottom-up: transitions with the given state in the left-hand side.
+ *
+ * Iteration over the view does not chase pointers through the transition
+ * cache.  The view is not updated when the original automaton changes.
+ */
+template <class T>
+class FlatTA
+{
+public:   // data types
+
+	typedef typename TA<T>::Transition Transition;
+
+	/// half-open range of positions in an array
+	typedef std::pair<const size_t*, const size_t*> range_type;
+
+private:  // data members
+
+	/// original states; a dense state is the position in this vector
+	std::vector<size_t> states_;
+
+	/// dense right-hand side of each transition
+	std::vector<size_t> rhs_;
+
+	/// label of each transition
+	std::vector<T> label_;
+
+	/// left-hand side of transition i is lhs_[lhsOffset_[i] .. lhsOffset_[i+1])
+	std::vector<size_t> lhsOffset_;
+	std::vector<size_t> lhs_;
+
+	/// the original transition in the cache of the TA
+	std::vector<const Transition*> orig_;
+
+	/// transitions of state s are tdOffset_[s] .. tdOffset_[s+1]
+	std::vector<size_t> tdOffset_;
+
+	/// transitions with s in lhs are buTrans_[buOffset_[s] .. buOffset_[s+1])
+	std::vector<size_t> buOffset_;
+	std::vector<size_t> buTrans_;
+
+private:  // methods
+
+	struct OrderF
+	{
+		bool operator()(const Transition* t1, const Transition* t2) const
+		{
+			if (t1->rhs() != t2->rhs())
+				return t1->rhs() < t2->rhs();
+
+			if (t1->label() != t2->label())
+				return t1->label() < t2->label();
+
+			return t1->lhs() < t2->lhs();
+		}
+	};
+
+	size_t dense(size_t state) const
+	{
+		std::vector<size_t>::const_iterator i =
+			std::lower_bound(states_.begin(), states_.end(), state);
+
+		assert((states_.end() != i) && (*i == state));
+		return i - states_.begin();
+	}
+
+public:   // methods
+
+	explicit FlatTA(const TA<T>& ta) :
+		states_{},
+		rhs_{},
+		label_{},
+		lhsOffset_{},
+		lhs_{},
+		orig_{},
+		tdOffset_{},
+		buOffset_{},
+		buTrans_{}
+	{
+		for (typename TA<T>::iterator i = ta.begin(); i != ta.end(); ++i)
+		{
+			orig_.push_back(&*i);
+			states_.push_back(i->rhs());
+			states_.insert(states_.end(), i->lhs().begin(), i->lhs().end());
+		}
+
+		std::sort(states_.begin(), states_.end());
+		states_.erase(std::unique(states_.begin(), states_.end()), states_.end());
+		std::sort(orig_.begin(), orig_.end(), OrderF());
+
+		const size_t count = orig_.size();
+		rhs_.reserve(count);
+		label_.reserve(count);
+		lhsOffset_.reserve(count + 1);
+		tdOffset_.assign(states_.size() + 1, 0);
+		buOffset_.assign(states_.size() + 1, 0);
+
+		for (const Transition* t : orig_)
+		{
+			const size_t rhs = this->dense(t->rhs());
+			rhs_.push_back(rhs);
+			label_.push_back(t->label());
+			lhsOffset_.push_back(lhs_.size());
+			++tdOffset_[rhs + 1];
+			for (size_t state : t->lhs())
+				lhs_.push_back(this->dense(state));
+		}
+
+		lhsOffset_.push_back(lhs_.size());
+
+		// the bottom-up index lists each transition once per state, even if
+		// the state occurs several times in its left-hand side
+		std::vector<size_t> last(states_.size(), count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			for (size_t k = lhsOffset_[i]; k < lhsOffset_[i + 1]; ++k)
+			{
+				if (last[lhs_[k]] != i)
+				{
+					last[lhs_[k]] = i;
+					++buOffset_[lhs_[k] + 1];
+				}
+			}
+		}
+
+		for (size_t s = 0; s < states_.size(); ++s)
+		{
+			tdOffset_[s + 1] += tdOffset_[s];
+			buOffset_[s + 1] += buOffset_[s];
+		}
+
+		std::vector<size_t> next(buOffset_.begin(), buOffset_.end() - 1);
+		last.assign(states_.size(), count);
+		buTrans_.resize(buOffset_.back());
+		for (size_t i = 0; i < count; ++i)
+		{
+			for (size_t k = lhsOffset_[i]; k < lhsOffset_[i + 1]; ++k)
+			{
+				if (last[lhs_[k]] != i)
+				{
+					last[lhs_[k]] = i;
+					buTrans_[next[lhs_[k]]++] = i;
+				}
+			}
+		}
+	}
+
+	/// the number of transitions
+	size_t size() const { return rhs_.size(); }
+
+	/// the number of (dense) states
+	size_t stateCount() const { return states_.size(); }
+
+	/// the original name of the dense state @p s
+	size_t state(size_t s) const { return states_[s]; }
+
+	/// does the automaton have a transition with the original state @p state?
+	bool hasState(size_t state) const
+	{
+		return std::binary_search(states_.begin(), states_.end(), state);
+	}
+
+	/// the dense name of the original state @p state (which must exist)
+	size_t find(size_t state) const { return this->dense(state); }
+
+	size_t rhs(size_t i) const { return rhs_[i]; }
+
+	const T& label(size_t i) const { return label_[i]; }
+
+	size_t lhsSize(size_t i) const { return lhsOffset_[i + 1] - lhsOffset_[i]; }
+
+	range_type lhs(size_t i) const
+	{
+		const size_t* base = lhs_.empty() ? nullptr : &lhs_[0];
+		return range_type(base + lhsOffset_[i], base + lhsOffset_[i + 1]);
+	}
+
+	const Transition& orig(size_t i) const { return *orig_[i]; }
+
+	/// transitions with the dense state @p s on the right-hand side
+	std::pair<size_t, size_t> tdRange(size_t s) const
+	{
+		return std::make_pair(tdOffset_[s], tdOffset_[s + 1]);
+	}
+
+	/// transitions with the dense state @p s in the left-hand side
+	range_type buRange(size_t s) const
+	{
+		const size_t* base = buTrans_.empty() ? nullptr : &buTrans_[0];
+		return range_type(base + buOffset_[s], base + buOffset_[s + 1]);
+	}
+};
+
+#endif
@@ -267,18 +267,16 @@ const ConnectionGraph::StateToCutpointSignatureMap& Folding::getSignatures(
 	// Preconditions
 	assert(root < signatureMap_.size());
 
-	if (!signatureMap_[root].first)
-	{	// if the signature is not valid, recompute it
-		ConnectionGraph::computeSignatures(
-			signatureMap_[root].second, *fae_.getRoot(root)
-		);
-
-		signatureMap_[root].first = true;
+	if (!signatureMap_[root])
+	{	// if the signature is not valid, look it up (the root may not have
+		// changed since the previous folding)
+		signatureMap_[root] =
+			ConnectionGraph::signatureCache().get(fae_.getRoot(root));
 	}
 
-	assert(signatureMap_[root].first);
+	assert(signatureMap_[root]);
 
-	return signatureMap_[root].second;
+	return *signatureMap_[root];
 }
 
 
@@ -613,9 +611,7 @@ void Folding::componentCut(
 			complementSignature[i].refCount =
 				std::max(complementSignature[i].refCount, tmp[i].refCount);
 
-			complementSignature[i].fwdSelectors.insert(
-				tmp[i].fwdSelectors.begin(), tmp[i].fwdSelectors.end()
-			);
+			complementSignature[i].fwdSelectors.insert(tmp[i].fwdSelectors);
 		}
 
 		// add the new transition to the source automaton
@@ -48,7 +48,9 @@ private:  // data members
 	FAE& fae_;
 	BoxMan& boxMan_;
 
-	std::vector<std::pair<bool, ConnectionGraph::StateToCutpointSignatureMap>> signatureMap_;
+	/// signatures of the roots, obtained from ConnectionGraph::signatureCache()
+	std::vector<std::shared_ptr<const ConnectionGraph::StateToCutpointSignatureMap>>
+		signatureMap_;
 
 protected:
 
@@ -128,7 +130,7 @@ protected:
 		// Preconditions
 		assert(root < signatureMap_.size());
 
-		signatureMap_[root].first = false;
+		signatureMap_[root].reset();
 	}
 
 
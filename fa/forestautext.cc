@@ -31,6 +31,9 @@ bool FAE::subseteq(const FAE& lhs, const FAE& rhs)
 
 	for (size_t i = 0; i < lhs.getRootCount(); ++i)
 	{
+		if (lhs.getRoot(i) == rhs.getRoot(i))
+			continue;     // a shared component
+
 		if (!TreeAut::subseteq(*lhs.getRoot(i), *rhs.getRoot(i)))
 			return false;
 	}
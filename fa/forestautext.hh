@@ -230,6 +230,12 @@ public:
 	}
 
 
+	/**
+	 * @brief  Adds the components of @p src to the components of this FA
+	 *
+	 * The components are modified in place, so they must not be shared with
+	 * other forest automata.
+	 */
 	template <class F>
 	void fuse(
 		const std::vector<FAE*>&       src,
@@ -280,6 +286,23 @@ public:
 		}
 	}
 
+	/**
+	 * @brief  Replaces the components by their canonical instances
+	 *
+	 * Components equal to components of other forest automata become shared
+	 * with them (see TreeAut::CanonicalStore).
+	 */
+	void internRoots()
+	{
+		for (std::shared_ptr<TreeAut>& ta : roots_)
+		{
+			if (!ta)
+				continue;
+
+			ta = TreeAut::canonicalStore().intern(ta);
+		}
+	}
+
 	void unreachableFree(std::shared_ptr<TreeAut>& ta)
 	{
 		std::shared_ptr<TreeAut> tmp = ta;
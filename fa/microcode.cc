@@ -531,11 +531,28 @@ void FI_iadd::execute(ExecutionManager& execMan, SymState& state)
 // FI_check
 void FI_check::execute(ExecutionManager& execMan, SymState& state)
 {
-	state.GetFAE()->updateConnectionGraph();
+	if (!execMan.parallel())
+	{
+		state.GetFAE()->updateConnectionGraph();
+
+		Normalization(const_cast<FAE&>(*(state.GetFAE())), &state).check();
 
-	Normalization(const_cast<FAE&>(*(state.GetFAE())), &state).check();
+		SymState* tmpState = execMan.createChildState(state, next_);
+		execMan.enqueue(tmpState);
+		return;
+	}
+
+	// the FAE may be shared with states explored by other threads, so the
+	// connection graph is computed on a private copy
+	std::shared_ptr<FAE> fae = std::shared_ptr<FAE>(new FAE(*(state.GetFAE())));
+
+	fae->updateConnectionGraph();
+
+	Normalization(*fae, &state).check();
 
 	SymState* tmpState = execMan.createChildState(state, next_);
+	tmpState->SetFAE(fae);
+
 	execMan.enqueue(tmpState);
 }
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPTIONAL_MUTEX_H
+#define OPTIONAL_MUTEX_H
+
+// Standard library headers
+#include <mutex>
+
+/**
+ * @brief  A mutex that is locked only when enabled
+ *
+ * Guards data structures that are shared by the workers of the parallel
+ * symbolic execution (tree automata backends, the box manager, the state
+ * tree). In the sequential mode the mutex is disabled and locking it costs
+ * a single test. The mutex must not be enabled or disabled while it is
+ * locked or while workers are running.
+ *
+ * Satisfies the BasicLockable requirements, i.e., it can be used with
+ * std::lock_guard.
+ */
+template <class Mutex = std::mutex>
+class OptionalMutex
+{
+private:  // data members
+
+	Mutex mutex_;
+
+	bool enabled_;
+
+public:   // methods
+
+	OptionalMutex() :
+		mutex_{},
+		enabled_{false}
+	{ }
+
+	OptionalMutex(const OptionalMutex&) = delete;
+	OptionalMutex& operator=(const OptionalMutex&) = delete;
+
+	void enable(bool enabled)
+	{
+		enabled_ = enabled;
+	}
+
+	bool enabled() const
+	{
+		return enabled_;
+	}
+
+	void lock()
+	{
+		if (enabled_)
+			mutex_.lock();
+	}
+
+	void unlock()
+	{
+		if (enabled_)
+			mutex_.unlock();
+	}
+};
+
+#endif
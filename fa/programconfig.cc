@@ -71,6 +71,13 @@ void ProgramConfig::processArg(const std::string& arg)
 		return;
 	}
 
+	if (std::string("incremental-restart") == key)
+	{
+		this->incrementalRestart = true;
+		FA_LOG("Config::processArg: \"incremental-restart\" mode requested");
+		return;
+	}
+
 	//      ***************  binary arguments ****************
 	if (std::string("db-root") == key)
 	{
@@ -84,5 +91,48 @@ void ProgramConfig::processArg(const std::string& arg)
 		return;
 	}
 
+	if (std::string("dump-fixpoints") == key)
+	{
+		if (data.size() != 2)
+		{
+			throw std::invalid_argument("use \"dump-fixpoints:<file>\"");
+		}
+
+		this->dumpFixpoints = data[1];
+		FA_LOG("Config::processArg: \"dump-fixpoints\" is \"" + this->dumpFixpoints + "\"");
+		return;
+	}
+
+	if (std::string("strategy") == key)
+	{
+		if (data.size() != 2)
+		{
+			throw std::invalid_argument("use \"strategy:<name>\"");
+		}
+
+		this->strategy = data[1];
+		FA_LOG("Config::processArg: \"strategy\" is \"" + this->strategy + "\"");
+		return;
+	}
+
+	if (std::string("threads") == key)
+	{
+		size_t threads = 0;
+		if ((data.size() == 2) && !data[1].empty()
+			&& (data[1].find_first_not_of("0123456789") == std::string::npos))
+		{
+			threads = std::stoul(data[1]);
+		}
+
+		if (0 == threads)
+		{
+			throw std::invalid_argument("use \"threads:<n>\" with n > 0");
+		}
+
+		this->threads = threads;
+		FA_LOG("Config::processArg: \"threads\" is " << this->threads);
+		return;
+	}
+
 	FA_WARN("unhandled argument: \"" << arg << "\"");
 }
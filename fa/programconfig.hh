@@ -36,6 +36,10 @@ public:   // data members
 	bool        onlyCompile;        ///< only compiling?
 	bool        printTrace;         ///< printing trace for errors?
 	bool        printUcodeTrace;    ///< printing microcode trace for errors?
+	bool        incrementalRestart; ///< resume instead of restart on new box?
+	std::string dumpFixpoints;      ///< file to dump fixpoints to (Timbuk)
+	size_t      threads;            ///< the number of exploring threads
+	std::string strategy;           ///< the state exploration strategy
 
 private:  // methods
 
@@ -49,7 +53,11 @@ public:   // methods
 		printOrigCode(false),
 		onlyCompile(false),
 		printTrace(false),
-		printUcodeTrace(false)
+		printUcodeTrace(false),
+		incrementalRestart(false),
+		dumpFixpoints(""),
+		threads(1),
+		strategy("dfs")
 	{
 		std::vector<std::string> args;
 		boost::split(args, confStr, boost::is_any_of(";"));
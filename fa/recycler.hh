@@ -17,93 +17,493 @@
  * along with forester.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef RECYCLER_H
 #define RECYCLER_H
 
+// Standard library headers
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
+/**
+ * @brief  Assigns slots of per-thread caches of recyclers to threads
+ *
+ * Each thread gets a unique index smaller than MAX_THREADS on its first use of
+ * a recycler; the index is released when the thread terminates and may be
+ * reused by another thread (which then inherits the cached objects). Threads
+ * that do not get an index use the shared pools of recyclers directly.
+ */
+class RecyclerThread
+{
+public:   // data members
+
+	static const size_t MAX_THREADS = 64;
+
+	static const size_t NONE = static_cast<size_t>(-1);
+
+private:  // data types
+
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<size_t> released;
+		size_t next;
+
+		Registry() :
+			mutex{},
+			released{},
+			next{0}
+		{ }
+	};
+
+	struct Slot
+	{
+		size_t index;
+
+		Slot() :
+			index(RecyclerThread::acquire())
+		{ }
+
+		~Slot()
+		{
+			RecyclerThread::release(index);
+		}
+	};
+
+private:  // methods
+
+	static Registry& registry()
+	{
+		// never destroyed, threads may terminate after static destructors
+		static Registry* registry = new Registry();
+		return *registry;
+	}
+
+	static size_t acquire()
+	{
+		Registry& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		if (!reg.released.empty())
+		{
+			const size_t index = reg.released.back();
+			reg.released.pop_back();
+			return index;
+		}
+
+		return (reg.next < MAX_THREADS)? reg.next++ : NONE;
+	}
+
+	static void release(size_t index)
+	{
+		if (NONE == index)
+			return;
+
+		Registry& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		reg.released.push_back(index);
+	}
+
+public:   // methods
+
+	/**
+	 * @brief  The index of the calling thread (or NONE)
+	 */
+	static size_t index()
+	{
+		static thread_local Slot slot;
+		return slot.index;
+	}
+};
+
+
+/**
+ * @brief  A pool of objects of the type @p T
+ *
+ * Objects are recycled instead of being deleted and reused by subsequent
+ * allocations (without being constructed again). Each thread has its own cache
+ * of free objects, which is accessed without any synchronization. Objects
+ * move between the caches of threads in batches of BATCH_SIZE through a shared
+ * lock-free stack, which is only pushed to and taken as a whole (therefore it
+ * does not suffer from the ABA problem).
+ *
+ * The recycler counts the objects allocated by @p new, the reused objects and
+ * the recycled objects.
+ */
 template <class T>
-class Recycler {
+class Recycler
+{
+public:   // data members
 
-	std::vector<T*> buffer_;
+	/// the maximal number of free objects in the cache of a thread
+	static const size_t CACHE_SIZE = 256;
 
-public:
+	/// the number of objects moved between a cache and the shared stack
+	static const size_t BATCH_SIZE = 128;
 
-	Recycler() :
-		buffer_{}
-	{ }
+private:  // data types
+
+	/// a batch of free objects in the shared stack
+	struct Batch
+	{
+		std::vector<T*> objects;
+		Batch* next;
+
+		Batch() :
+			objects{},
+			next{nullptr}
+		{ }
+
+		Batch(const Batch&) = delete;
+		Batch& operator=(const Batch&) = delete;
+	};
+
+	/// the cache of free objects of a thread
+	struct ThreadCache
+	{
+		std::vector<T*> objects;
+
+		/// counters (written only by the owning thread)
+		std::atomic<size_t> allocated;
+		std::atomic<size_t> reused;
+		std::atomic<size_t> recycled;
+
+		/// avoids false sharing of the counters of different threads
+		char padding[64];
 
-	~Recycler() { this->clear(); }
+		ThreadCache() :
+			objects{},
+			allocated{0},
+			reused{0},
+			recycled{0},
+			padding()
+		{ }
+	};
+
+	/// adds @p n to a counter of a single writer
+	static void add(std::atomic<size_t>& counter, size_t n)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + n,
+			std::memory_order_relaxed);
+	}
+
+private:  // data members
+
+	std::unique_ptr<ThreadCache[]> caches_;
+
+	/// the shared stack of batches of free objects
+	std::atomic<Batch*> shared_;
+
+	/// counters of threads without a cache
+	std::atomic<size_t> allocated_;
+	std::atomic<size_t> reused_;
+	std::atomic<size_t> recycled_;
 
-	void clear() {
+private:  // methods
 
-		for (auto obj : this->buffer_)
-			delete obj;
+	Recycler(const Recycler&);
+	Recycler& operator=(const Recycler&);
 
-		this->buffer_.clear();
+	/**
+	 * @brief  Pushes a list of batches to the shared stack
+	 */
+	void pushShared(Batch* first)
+	{
+		Batch* last = first;
+		while (nullptr != last->next)
+			last = last->next;
 
+		last->next = shared_.load(std::memory_order_relaxed);
+		while (!shared_.compare_exchange_weak(last->next, first,
+			std::memory_order_release, std::memory_order_relaxed))
+		{ }
 	}
 
-	T* alloc() {
+	/**
+	 * @brief  Takes a batch from the shared stack (@p nullptr if empty)
+	 */
+	Batch* popShared()
+	{
+		Batch* first = shared_.exchange(nullptr, std::memory_order_acquire);
+		if (nullptr == first)
+			return nullptr;
 
-		T* obj;
+		if (nullptr != first->next)
+			this->pushShared(first->next);
 
-		if (this->buffer_.empty()) {
-			obj = new T();
-		} else {
-			obj = this->buffer_.back();
-			this->buffer_.pop_back();
+		first->next = nullptr;
+		return first;
+	}
+
+	/**
+	 * @brief  Moves a batch of free objects from @p objects to the shared stack
+	 */
+	void flush(std::vector<T*>& objects)
+	{
+		while (objects.size() > CACHE_SIZE)
+		{
+			Batch* batch = new Batch();
+			batch->objects.assign(objects.end() - BATCH_SIZE, objects.end());
+			objects.resize(objects.size() - BATCH_SIZE);
+			this->pushShared(batch);
 		}
+	}
+
+	template <class F>
+	T* allocShared(F f)
+	{
+		Batch* batch = this->popShared();
+		if (nullptr == batch)
+		{
+			++allocated_;
+			return f();
+		}
+
+		T* obj = batch->objects.back();
+		batch->objects.pop_back();
+		if (batch->objects.empty())
+			delete batch;
+		else
+			this->pushShared(batch);
 
+		++reused_;
 		return obj;
+	}
 
+	void recycleShared(T* obj)
+	{
+		Batch* batch = new Batch();
+		batch->objects.push_back(obj);
+		this->pushShared(batch);
+		++recycled_;
 	}
 
-	template <class F>
-	T* alloc(F f) {
+public:   // methods
+
+	Recycler() :
+		caches_(new ThreadCache[RecyclerThread::MAX_THREADS]),
+		shared_{nullptr},
+		allocated_{0},
+		reused_{0},
+		recycled_{0}
+	{ }
+
+	~Recycler()
+	{
+		this->clear();
+	}
 
-		T* obj;
+	/**
+	 * @brief  Deletes all free objects
+	 *
+	 * May be called only when no other thread uses the recycler.
+	 */
+	void clear()
+	{
+		for (size_t i = 0; i < RecyclerThread::MAX_THREADS; ++i)
+		{
+			for (T* obj : caches_[i].objects)
+				delete obj;
 
-		if (this->buffer_.empty()) {
-			obj = f();
-		} else {
-			obj = this->buffer_.back();
-			this->buffer_.pop_back();
+			caches_[i].objects.clear();
 		}
 
-		return obj;
+		Batch* batch = shared_.exchange(nullptr);
+		while (nullptr != batch)
+		{
+			for (T* obj : batch->objects)
+				delete obj;
 
+			Batch* next = batch->next;
+			delete batch;
+			batch = next;
+		}
 	}
-/*
-	T* alloc(Args&&... params) {
 
-		T* obj;
+	T* alloc()
+	{
+		return this->alloc([]() { return new T(); });
+	}
+
+	template <class F>
+	T* alloc(F f)
+	{
+		const size_t index = RecyclerThread::index();
+		if (RecyclerThread::NONE == index)
+			return this->allocShared(f);
+
+		ThreadCache& cache = caches_[index];
+		if (cache.objects.empty())
+		{	// refill the cache from the shared stack
+			Batch* batch = this->popShared();
+			if (nullptr == batch)
+			{
+				add(cache.allocated, 1);
+				return f();
+			}
 
-		if (this->buffer_.empty()) {
-			obj = new T(std::forward<Args>(params)...);
-		} else {
-			obj = this->buffer_.back();
-			this->buffer_.pop_back();
-			obj->init(std::forward<Args>(params)...);
+			cache.objects.swap(batch->objects);
+			delete batch;
 		}
 
-		return obj;
+		T* obj = cache.objects.back();
+		cache.objects.pop_back();
+		add(cache.reused, 1);
 
+		return obj;
 	}
-*/
+
 	struct NoOp {
 		void operator()(Recycler<T>&, T*) {}
 	};
 
 	template <class F = NoOp>
-	void recycle(T* obj, F f = NoOp()) {
-
-		this->buffer_.push_back(obj);
+	void recycle(T* obj, F f = NoOp())
+	{
+		const size_t index = RecyclerThread::index();
+		if (RecyclerThread::NONE == index)
+		{
+			this->recycleShared(obj);
+		}
+		else
+		{
+			ThreadCache& cache = caches_[index];
+			cache.objects.push_back(obj);
+			add(cache.recycled, 1);
+			this->flush(cache.objects);
+		}
 
 		f(*this, obj);
+	}
+
+	/**
+	 * @brief  Recycles all objects of @p objects at once
+	 */
+	void recycleAll(const std::vector<T*>& objects)
+	{
+		const size_t index = RecyclerThread::index();
+		if (RecyclerThread::NONE == index)
+		{
+			for (T* obj : objects)
+				this->recycleShared(obj);
+
+			return;
+		}
+
+		ThreadCache& cache = caches_[index];
+		cache.objects.insert(cache.objects.end(), objects.begin(), objects.end());
+		add(cache.recycled, objects.size());
+		this->flush(cache.objects);
+	}
+
+	/**
+	 * @brief  The number of objects allocated by @p new
+	 */
+	size_t allocated() const
+	{
+		size_t sum = allocated_;
+		for (size_t i = 0; i < RecyclerThread::MAX_THREADS; ++i)
+			sum += caches_[i].allocated.load(std::memory_order_relaxed);
+
+		return sum;
+	}
+
+	/**
+	 * @brief  The number of allocations served by a recycled object
+	 */
+	size_t reused() const
+	{
+		size_t sum = reused_;
+		for (size_t i = 0; i < RecyclerThread::MAX_THREADS; ++i)
+			sum += caches_[i].reused.load(std::memory_order_relaxed);
+
+		return sum;
+	}
+
+	/**
+	 * @brief  The number of recycled objects
+	 */
+	size_t recycled() const
+	{
+		size_t sum = recycled_;
+		for (size_t i = 0; i < RecyclerThread::MAX_THREADS; ++i)
+			sum += caches_[i].recycled.load(std::memory_order_relaxed);
+
+		return sum;
+	}
+};
+
+
+/**
+ * @brief  An allocator of single objects from a recycler
+ *
+ * Allocations of single objects (e.g. nodes of node-based containers) are
+ * served by a recycler of memory blocks shared by all allocators of the same
+ * type, other allocations (e.g. bucket arrays) by the global @p new. The
+ * memory of recycled blocks is never returned to the system.
+ */
+template <class T>
+class PoolAllocator
+{
+public:   // data types
+
+	typedef T value_type;
 
+	/// a raw memory block for a single object
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Block;
+
+public:   // methods
+
+	PoolAllocator()
+	{ }
+
+	template <class U>
+	PoolAllocator(const PoolAllocator<U>&)
+	{ }
+
+	/**
+	 * @brief  The recycler of blocks of the allocator
+	 */
+	static Recycler<Block>& pool()
+	{
+		// never destroyed, containers may be destroyed after static destructors
+		static Recycler<Block>* pool = new Recycler<Block>();
+		return *pool;
+	}
+
+	T* allocate(size_t n)
+	{
+		if (1 != n)
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+
+		return reinterpret_cast<T*>(pool().alloc());
 	}
 
+	void deallocate(T* p, size_t n)
+	{
+		if (1 != n)
+		{
+			::operator delete(p);
+			return;
+		}
+
+		pool().recycle(reinterpret_cast<Block*>(p));
+	}
 };
 
+template <class T, class U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+	return true;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+	return false;
+}
+
 #endif
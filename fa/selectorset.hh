@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SELECTOR_SET_H
+#define SELECTOR_SET_H
+
+/**
+ * @file selectorset.hh
+ * SelectorSet - a small set of selector offsets stored as a bitset
+ */
+
+// Standard library headers
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Boost headers
+#include <boost/functional/hash.hpp>
+
+/**
+ * @brief  A set of selector offsets
+ *
+ * Replaces @p std::set<size_t> in cutpoint signatures. Selector offsets are
+ * small, so the set is a bitset: offsets below 64 live in an inline word,
+ * larger ones in additional words allocated on demand. The offset @p -1
+ * (no selector) is stored as a flag. Iteration visits the elements in the
+ * increasing order, i.e. @p -1 is the last one, the same as for
+ * @p std::set<size_t>.
+ */
+class SelectorSet
+{
+public:   // data types
+
+	typedef size_t value_type;
+
+	/// a forward iterator over the elements of the set
+	class const_iterator
+	{
+	public:   // data types
+
+		typedef std::forward_iterator_tag iterator_category;
+		typedef size_t value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const size_t* pointer;
+		typedef const size_t& reference;
+
+	private:  // data members
+
+		const SelectorSet* set_;
+
+		/// the current element, END past the last one
+		size_t pos_;
+
+	public:   // methods
+
+		const_iterator(const SelectorSet* set, size_t pos) :
+			set_(set),
+			pos_(pos)
+		{ }
+
+		const size_t& operator*() const
+		{
+			assert(END != pos_);
+			return pos_;
+		}
+
+		const_iterator& operator++()
+		{
+			pos_ = (NONE == pos_)? END : set_->findFrom(pos_ + 1);
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const const_iterator& rhs) const
+		{
+			return pos_ == rhs.pos_;
+		}
+
+		bool operator!=(const const_iterator& rhs) const
+		{
+			return pos_ != rhs.pos_;
+		}
+	};
+
+	typedef const_iterator iterator;
+
+public:   // constants
+
+	/// no selector
+	static const size_t NONE = static_cast<size_t>(-1);
+
+	/// the largest offset that can be stored (besides NONE)
+	static const size_t MAX_OFFSET = (static_cast<size_t>(1) << 20) - 1;
+
+private:  // constants
+
+	static const size_t BITS = 64;
+
+	/// the position of the end iterator
+	static const size_t END = NONE - 1;
+
+private:  // data members
+
+	/// offsets 0..63
+	uint64_t low_;
+
+	/// offsets from 64 on, the last word is never zero
+	std::vector<uint64_t> high_;
+
+	/// is NONE in the set?
+	bool none_;
+
+private:  // methods
+
+	uint64_t word(size_t i) const
+	{
+		return (0 == i)? low_ : high_[i - 1];
+	}
+
+	size_t wordCount() const
+	{
+		return 1 + high_.size();
+	}
+
+	/**
+	 * @brief  The first element that is not smaller than @p pos
+	 */
+	size_t findFrom(size_t pos) const
+	{
+		for (size_t i = pos / BITS; i < this->wordCount(); ++i)
+		{
+			uint64_t w = this->word(i);
+			if (i == pos / BITS)
+				w &= ~static_cast<uint64_t>(0) << (pos % BITS);
+
+			if (w)
+				return i * BITS + __builtin_ctzll(w);
+		}
+
+		return none_? NONE : END;
+	}
+
+public:   // methods
+
+	SelectorSet() :
+		low_(0),
+		high_{},
+		none_(false)
+	{ }
+
+	/**
+	 * @brief  Can @p offset be stored in the set?
+	 */
+	static bool isValid(size_t offset)
+	{
+		return offset <= MAX_OFFSET || NONE == offset;
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, this->findFrom(0));
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, END);
+	}
+
+	bool empty() const
+	{
+		return !none_ && !low_ && high_.empty();
+	}
+
+	size_t size() const
+	{
+		size_t result = none_;
+		for (size_t i = 0; i < this->wordCount(); ++i)
+			result += __builtin_popcountll(this->word(i));
+
+		return result;
+	}
+
+	bool count(size_t offset) const
+	{
+		if (NONE == offset)
+			return none_;
+
+		const size_t i = offset / BITS;
+		return i < this->wordCount() && (this->word(i) >> (offset % BITS)) & 1;
+	}
+
+	void clear()
+	{
+		low_ = 0;
+		high_.clear();
+		none_ = false;
+	}
+
+	void insert(size_t offset)
+	{
+		// Assertions
+		assert(SelectorSet::isValid(offset));
+
+		if (NONE == offset)
+		{
+			none_ = true;
+			return;
+		}
+
+		const uint64_t bit = static_cast<uint64_t>(1) << (offset % BITS);
+		const size_t i = offset / BITS;
+		if (0 == i)
+		{
+			low_ |= bit;
+			return;
+		}
+
+		if (high_.size() < i)
+			high_.resize(i, 0);
+
+		high_[i - 1] |= bit;
+	}
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for ( ; first != last; ++first)
+			this->insert(*first);
+	}
+
+	/**
+	 * @brief  Inserts all elements of @p rhs (set union)
+	 */
+	void insert(const SelectorSet& rhs)
+	{
+		low_ |= rhs.low_;
+		none_ |= rhs.none_;
+		if (high_.size() < rhs.high_.size())
+			high_.resize(rhs.high_.size(), 0);
+
+		for (size_t i = 0; i < rhs.high_.size(); ++i)
+			high_[i] |= rhs.high_[i];
+	}
+
+	/**
+	 * @brief  Do the sets have no element in common?
+	 */
+	bool isDisjoint(const SelectorSet& rhs) const
+	{
+		if ((low_ & rhs.low_) || (none_ && rhs.none_))
+			return false;
+
+		const size_t n = std::min(high_.size(), rhs.high_.size());
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (high_[i] & rhs.high_[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief  Is every element of @p rhs in the set?
+	 */
+	bool includes(const SelectorSet& rhs) const
+	{
+		if ((rhs.low_ & ~low_) || (rhs.none_ && !none_)
+			|| rhs.high_.size() > high_.size())
+			return false;
+
+		for (size_t i = 0; i < rhs.high_.size(); ++i)
+		{
+			if (rhs.high_[i] & ~high_[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	bool operator==(const SelectorSet& rhs) const
+	{
+		return low_ == rhs.low_ && none_ == rhs.none_ && high_ == rhs.high_;
+	}
+
+	bool operator!=(const SelectorSet& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	friend size_t hash_value(const SelectorSet& set)
+	{
+		size_t seed = 0;
+		boost::hash_combine(seed, set.low_);
+		boost::hash_combine(seed, set.high_);
+		boost::hash_combine(seed, set.none_);
+		return seed;
+	}
+};
+
+#endif
@@ -593,9 +593,8 @@ public:
 		return this->_relation;
 	}
 	
-	void buildRel(size_t size, std::vector<std::vector<bool> >& rel) const {
-		rel.clear();
-		rel.resize(size, std::vector<bool>(size));
+	void buildRel(size_t size, BitMatrix& rel) const {
+		rel.assign(size, false);
 		for (size_t i = 0; i < size; ++i) {
 			size_t ii = this->_index[i]->block()->index();
 			for (size_t j = 0; j < size; ++j)
@@ -22,6 +22,7 @@
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
+#include <mutex>
 #include <unistd.h>
 
 // Code Listener headers
@@ -46,6 +47,9 @@ namespace
 	/// debugging level
 	int debugLvl = 0;
 
+	/// serializes messages of workers of the parallel execution
+	std::recursive_mutex printMutex;
+
 	/**
 	 * @brief  
 	 *
@@ -172,6 +176,7 @@ void Streams::callPrintFnc(
 		locStr = str.c_str();
 	}
 
+	std::lock_guard<std::recursive_mutex> lock(printMutex);
 	fnc(locStr, msg);
 }
 
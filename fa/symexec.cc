@@ -36,7 +36,12 @@ void reportErrorNoLocation(const char* errMsg)
 
 
 // Standard library headers
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 #include <list>
 #include <set>
@@ -52,6 +57,7 @@ void reportErrorNoLocation(const char* errMsg)
 
 // Forester headers
 #include "backward_run.hh"
+#include "boxdb.hh"
 #include "executionmanager.hh"
 #include "fixpoint.hh"
 #include "fixpointinstruction.hh"
@@ -201,6 +207,15 @@ private:  // data members
 
 	const ProgramConfig& conf_;
 
+	/// the persistent database of boxes
+	BoxDb boxDb_;
+
+	/// the number of resumptions of the analysis after learning a box
+	size_t resumptions_;
+
+	/// the number of evaluated states kept over all resumptions
+	size_t statesKept_;
+
 	volatile bool dbgFlag_;
 	volatile bool userRequestFlag_;
 
@@ -235,6 +250,52 @@ protected:
 		}
 	}
 
+	/**
+	 * @brief  Dumps all fixpoints to a file in the Timbuk format
+	 *
+	 * Labels are renamed to l0, l1, ... so that the output can be parsed back
+	 * (e.g. by the ta_bench tool).
+	 *
+	 * @param[in]  fileName  Name of the output file
+	 */
+	void dumpFixpoints(const std::string& fileName) const
+	{
+		std::ofstream os(fileName.c_str());
+		if (!os)
+		{
+			FA_WARN("unable to open \"" << fileName << "\" for writing");
+			return;
+		}
+
+		TA<std::string>::Backend backend;
+		Index<label_type> labelIndex;
+		size_t cnt = 0;
+		for (auto instr : assembly_.code_)
+		{
+			if (instr->getType() != fi_type_e::fiFix)
+				continue;
+
+			const TreeAut& fixpoint =
+				static_cast<FixpointInstruction*>(instr)->getFixPoint();
+
+			TA<std::string> ta(backend);
+			for (const TT<label_type>& trans : fixpoint)
+			{
+				std::ostringstream label;
+				label << 'l' << labelIndex.translateOTF(trans.label());
+				ta.addTransition(trans.lhs(), label.str(), trans.rhs());
+			}
+
+			for (size_t state : fixpoint.getFinalStates())
+				ta.addFinalState(state);
+
+			std::ostringstream name;
+			name << "fixpoint" << cnt++;
+			TAWriter<std::string>(os).writeOne(ta, name.str());
+			os << std::endl;
+		}
+	}
+
 	/**
 	 * @brief  Clears all fixpoints
 	 */
@@ -252,6 +313,154 @@ protected:
 	}
 
 
+	/**
+	 * @brief  Resumes the analysis after a new box has been learnt
+	 *
+	 * Unlike a full restart, the part of the state space explored so far is
+	 * kept. Fixpoints whose configurations can be folded using the new box are
+	 * re-folded, the other fixpoints are kept untouched. The analysis then
+	 * continues from the interrupted state and the states still in the queue.
+	 *
+	 * @param[in]  state  The state whose execution has been interrupted
+	 */
+	void resume(SymState& state)
+	{
+		size_t fixpoints = 0;
+		size_t refolded = 0;
+		for (auto instr : assembly_.code_)
+		{
+			if (instr->getType() != fi_type_e::fiFix)
+			{
+				continue;
+			}
+
+			++fixpoints;
+			if (static_cast<FixpointInstruction*>(instr)->refold())
+			{
+				++refolded;
+			}
+		}
+
+		// the interrupted state is executed again (with the new box)
+		execMan_.enqueue(&state);
+
+		// a full restart would throw away all states evaluated so far
+		const size_t kept = execMan_.statesEvaluated();
+		++resumptions_;
+		statesKept_ += kept;
+
+		FA_NOTE("Resuming the analysis (" << refolded << " of " << fixpoints
+			<< " fixpoint(s) re-folded, " << kept << " evaluated state(s) kept)...");
+	}
+
+	/**
+	 * @brief  Executes a single state
+	 *
+	 * @param[in,out]  state  The state to be executed
+	 */
+	void processState(SymState& state)
+	{
+		const CodeStorage::Insn* insn = state.GetInstr()->insn();
+		if (nullptr != insn)
+		{	// in case current instruction IS an instruction
+			FA_DEBUG_AT(2, SSD_INLINE_COLOR(C_LIGHT_RED, insn->loc << *insn));
+			FA_DEBUG_AT(2, state);
+		}
+		else
+		{
+			FA_DEBUG_AT(3, state);
+		}
+
+		if (testAndClearUserRequestFlag())
+		{
+			FA_NOTE("Executed " << std::setw(7) << execMan_.statesEvaluated()
+				<< " states and " << std::setw(7) << execMan_.pathsEvaluated()
+				<< " paths so far.");
+		}
+
+		// run the state
+		execMan_.execute(state);
+	}
+
+	/**
+	 * @brief  Allows the shared data structures to be used by several threads
+	 */
+	void setConcurrent(bool concurrent)
+	{
+		taBackend_.setConcurrent(concurrent);
+		fixpointBackend_.setConcurrent(concurrent);
+		boxMan_.setConcurrent(concurrent);
+	}
+
+	/**
+	 * @brief  Processes all queued states using several threads
+	 *
+	 * Each thread executes states from its own deque and steals states of other
+	 * threads when idle. The first exception thrown by the execution of a state
+	 * stops all threads and is rethrown (after the threads are joined), so that
+	 * it is handled in the same way as in the sequential run. States whose
+	 * execution fails later are put back to the queue.
+	 *
+	 * @param[out]  state  The state whose execution threw the exception
+	 */
+	void runParallel(SymState*& state)
+	{
+		this->setConcurrent(true);
+		execMan_.startWorkers(conf_.threads);
+
+		std::atomic<bool> stop{false};
+		std::mutex errorMutex;
+		std::exception_ptr error;
+		SymState* failedState = nullptr;
+
+		auto worker = [&](size_t id)
+		{
+			execMan_.setWorker(id);
+
+			SymState* current;
+			while (nullptr != (current = execMan_.dequeue(id, stop)))
+			{
+				try
+				{
+					this->processState(*current);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if (!error)
+					{
+						error = std::current_exception();
+						failedState = current;
+						stop = true;
+					}
+					else
+					{	// to be executed again once the first error is handled
+						execMan_.enqueue(current);
+					}
+				}
+
+				execMan_.stateDone();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < conf_.threads; ++i)
+			threads.push_back(std::thread(worker, i));
+
+		// the calling thread is the worker 0
+		worker(0);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		execMan_.stopWorkers();
+		this->setConcurrent(false);
+
+		state = failedState;
+		if (error)
+			std::rethrow_exception(error);
+	}
+
 	/**
 	 * @brief  The main execution loop
 	 *
@@ -311,128 +520,127 @@ protected:
 
 		SymState* state = nullptr;
 
-		try
-		{	// expecting problems...
-			while (nullptr != (state = execMan_.dequeueDFS()))
-			{	// process all states in the DFS order
-				assert(nullptr != state);
+		for (;;)
+		{	// until the analysis terminates or needs to be restarted
+			try
+			{	// expecting problems...
+				if (conf_.threads > 1)
+				{	// process all states using several threads
+					this->runParallel(state);
 
-				const CodeStorage::Insn* insn = state->GetInstr()->insn();
-				if (nullptr != insn)
-				{	// in case current instruction IS an instruction
-					FA_DEBUG_AT(2, SSD_INLINE_COLOR(C_LIGHT_RED, insn->loc << *insn));
-					FA_DEBUG_AT(2, *state);
-				}
-				else
-				{
-					FA_DEBUG_AT(3, *state);
+					return true;
 				}
 
-				if (testAndClearUserRequestFlag())
-				{
-					FA_NOTE("Executed " << std::setw(7) << execMan_.statesEvaluated()
-						<< " states and " << std::setw(7) << execMan_.pathsEvaluated()
-						<< " paths so far.");
+				while (nullptr != (state = execMan_.dequeue()))
+				{	// process all states in the order given by the strategy
+					assert(nullptr != state);
+
+					this->processState(*state);
 				}
 
-				// run the state
-				execMan_.execute(*state);
+				return true;
 			}
+			catch (ProgramError& e)
+			{
+				assert(nullptr != e.state());
 
-			return true;
-		}
-		catch (ProgramError& e)
-		{
-			assert(nullptr != e.state());
+				const CodeStorage::Insn* insn = e.state()->GetInstr()->insn();
+				if (nullptr != insn)
+				{
+					FA_NOTE_MSG(&insn->loc, SSD_INLINE_COLOR(C_LIGHT_RED, *insn));
+					FA_DEBUG_AT(2, std::endl << *(e.state()->GetFAE()));
+				}
 
-			const CodeStorage::Insn* insn = e.state()->GetInstr()->insn();
-			if (nullptr != insn)
-			{
-				FA_NOTE_MSG(&insn->loc, SSD_INLINE_COLOR(C_LIGHT_RED, *insn));
-				FA_DEBUG_AT(2, std::endl << *(e.state()->GetFAE()));
-			}
+				if (nullptr != e.location())
+					FA_ERROR_MSG(e.location(), e.what());
+				else
+					reportErrorNoLocation(e.what());
 
-			if (nullptr != e.location())
-				FA_ERROR_MSG(e.location(), e.what());
-			else
-				reportErrorNoLocation(e.what());
+				if (conf_.printTrace)
+				{
+					FA_LOG_MSG(e.location(), "Printing trace");
 
-			if (conf_.printTrace)
-			{
-				FA_LOG_MSG(e.location(), "Printing trace");
+					std::ostringstream oss;
+					printTrace(oss, e.state()->getTrace());
+					Streams::trace(oss.str().c_str());
+				}
 
-				std::ostringstream oss;
-				printTrace(oss, e.state()->getTrace());
-				Streams::trace(oss.str().c_str());
-			}
+				if (conf_.printUcodeTrace)
+				{
+					FA_LOG_MSG(e.location(), "Printing microcode trace");
 
-			if (conf_.printUcodeTrace)
-			{
-				FA_LOG_MSG(e.location(), "Printing microcode trace");
+					std::ostringstream oss;
+					printUcodeTrace(oss, e.state()->getTrace());
+					Streams::traceUcode(oss.str().c_str());
+				}
 
-				std::ostringstream oss;
-				printUcodeTrace(oss, e.state()->getTrace());
-				Streams::traceUcode(oss.str().c_str());
-			}
+				if (FA_USE_PREDICATE_ABSTRACTION)
+				{	// in case we are using predicate abstraction
+					FA_LOG("Executing backward run...");
 
-			if (FA_USE_PREDICATE_ABSTRACTION)
-			{	// in case we are using predicate abstraction
-				FA_LOG("Executing backward run...");
+					// check whether the counterexample is spurious and in case it is collect
+					// some perhaps helpful information (failpoint and predicate)
+					BackwardRun bwdRun(execMan_);
+					SymState::Trace trace = e.state()->getTrace();
+					SymState* failPoint = nullptr;
+					std::shared_ptr<const FAE> predicate = nullptr;
 
-				// check whether the counterexample is spurious and in case it is collect
-				// some perhaps helpful information (failpoint and predicate)
-				BackwardRun bwdRun(execMan_);
-				SymState::Trace trace = e.state()->getTrace();
-				SymState* failPoint = nullptr;
-				std::shared_ptr<const FAE> predicate = nullptr;
+					bool isSpurious = bwdRun.isSpuriousCE(trace, failPoint, predicate);
+					if (isSpurious)
+					{
+						assert(nullptr != predicate);
+						assert(nullptr != failPoint);
+						assert(nullptr != failPoint->GetInstr());
 
-				bool isSpurious = bwdRun.isSpuriousCE(trace, failPoint, predicate);
-				if (isSpurious)
-				{
-					assert(nullptr != predicate);
-					assert(nullptr != failPoint);
-					assert(nullptr != failPoint->GetInstr());
+						FA_NOTE("The counterexample IS (PROBABLY) spurious");
 
-					FA_NOTE("The counterexample IS (PROBABLY) spurious");
+						FA_NOTE("Failing instuction: " << *failPoint->GetInstr());
+						FA_NOTE("Learnt predicate: " << *predicate);
 
-					FA_NOTE("Failing instuction: " << *failPoint->GetInstr());
-					FA_NOTE("Learnt predicate: " << *predicate);
+						// now, we add 'predicate' to the set of predicates that are used for
+						// abstraction at failPoint (which should BTW be abstraction)
 
-					// now, we add 'predicate' to the set of predicates that are used for
-					// abstraction at failPoint (which should BTW be abstraction)
+						FI_abs* absInstr = dynamic_cast<FI_abs*>(failPoint->GetInstr());
+						if (nullptr == absInstr)
+						{
+							assert(false);
+						}
 
-					FI_abs* absInstr = dynamic_cast<FI_abs*>(failPoint->GetInstr());
-					if (nullptr == absInstr)
-					{
-						assert(false);
-					}
+						// set the new predicate for abstraction
+						absInstr->addPredicate(predicate);
 
-					// set the new predicate for abstraction
-					absInstr->addPredicate(predicate);
+						clearFixpoints();
 
-					clearFixpoints();
+						return false;
+					}
+					else
+					{	// if the counterexample is not spurious
+						FA_NOTE("The counterexample IS real");
 
-					return false;
+						throw;
+					}
 				}
 				else
-				{	// if the counterexample is not spurious
-					FA_NOTE("The counterexample IS real");
-
+				{	// in case we are using finite height abstraction
 					throw;
 				}
 			}
-			else
-			{	// in case we are using finite height abstraction
-				throw;
-			}
-		}
-		catch (RestartRequest& e)
-		{	// in case a restart is requested, clear all fixpoint computation points
-			clearFixpoints();
+			catch (RestartRequest& e)
+			{
+				FA_DEBUG_AT(2, e.what());
 
-			FA_DEBUG_AT(2, e.what());
+				if (conf_.incrementalRestart && (nullptr != state))
+				{	// resume the analysis instead of restarting it
+					this->resume(*state);
 
-			return false;
+					continue;
+				}
+
+				// in case a restart is requested, clear all fixpoint computation points
+				clearFixpoints();
+
+				return false;
+			}
 		}
 	}
 
@@ -451,9 +659,20 @@ public:   // methods
 		assembly_{},
 		execMan_{},
 		conf_(conf),
+		boxDb_(conf.dbRoot),
+		resumptions_{0},
+		statesKept_{0},
 		dbgFlag_{false},
 		userRequestFlag_{false}
-	{ }
+	{
+		execMan_.setStrategy(conf.strategy);
+
+		if ((conf.threads > 1) && (conf.strategy != "dfs"))
+		{
+			FA_WARN("the exploration strategy \"" << conf.strategy
+				<< "\" is not used by parallel workers (they use DFS)");
+		}
+	}
 
 	/**
 	 * @brief  Loads types from a storage
@@ -548,23 +767,33 @@ public:   // methods
 			<< *boxMan_.getTypeInfo(GLOBAL_VARS_BLOCK_STR));
 	}
 
-#if 0
-	void loadBoxes(const std::unordered_map<std::string, std::string>& db) {
+	/**
+	 * @brief  Loads boxes from the persistent box database
+	 *
+	 * Loads boxes stored by previous runs into the box manager (the types of
+	 * the program need to be loaded first). Does nothing if no database root
+	 * directory is configured.
+	 */
+	void loadBoxes()
+	{
+		if (conf_.dbRoot.empty())
+			return;
 
 		FA_DEBUG_AT(2, "loading boxes ...");
 
-		for (auto p : db) {
-
-			this->boxes.push_back((const Box*)boxMan_.loadBox(p.first, db));
-
-			FA_DEBUG(p.first << ':' << std::endl << *(const FA*)this->boxes.back());
-
-		}
+		boxDb_.load(boxMan_, taBackend_);
+	}
 
-		boxMan_.buildBoxHierarchy(this->hierarchy, this->basicBoxes);
+	/**
+	 * @brief  Stores learnt boxes into the persistent box database
+	 */
+	void storeBoxes()
+	{
+		if (conf_.dbRoot.empty())
+			return;
 
+		boxDb_.store(boxMan_);
 	}
-#endif
 
 	void compile(const CodeStorage::Storage& stor, const CodeStorage::Fnc& entry)
 	{
@@ -581,6 +810,9 @@ public:   // methods
 		// Assertions
 		assert(assembly_.code_.size());
 
+		resumptions_ = 0;
+		statesKept_ = 0;
+
 		try
 		{	// expect problems...
 			while (!this->mainLoop())
@@ -611,10 +843,45 @@ public:   // methods
 				}
 			}
 
+			if (!conf_.dumpFixpoints.empty())
+				this->dumpFixpoints(conf_.dumpFixpoints);
+
 			// print out stats
 			FA_DEBUG_AT(1, "forester has generated " << execMan_.statesEvaluated()
 				<< " symbolic configuration(s) in " << execMan_.pathsEvaluated()
 				<< " path(s) using " << boxMan_.boxDatabase().size() << " box(es)");
+
+			FA_DEBUG_AT(1, "exploration strategy \"" << execMan_.strategyName()
+				<< "\": " << execMan_.statesEvaluated() << " state(s) evaluated, "
+				<< "at most " << execMan_.maxQueueSize() << " state(s) queued");
+
+			const Recycler<SymState>& states = execMan_.stateRecycler();
+			const Recycler<DataArray>& regs = execMan_.registerRecycler();
+			FA_DEBUG_AT(1, "states: " << states.allocated() << " allocated, "
+				<< states.reused() << " reused, " << states.recycled() << " recycled; "
+				<< "register files: " << regs.allocated() << " allocated, "
+				<< regs.reused() << " reused, " << regs.recycled() << " recycled");
+
+			const TreeAut::InclusionCache& incCache = TreeAut::inclusionCache();
+			FA_DEBUG_AT(1, "inclusion cache answered " << incCache.hits()
+				<< " of " << incCache.queries() << " inclusion check(s) ("
+				<< incCache.negativeHits() << " negative)");
+
+			const TreeAut::CanonicalStore& canonStore = TreeAut::canonicalStore();
+			FA_DEBUG_AT(1, "canonical store shared " << canonStore.shared()
+				<< " component(s)");
+
+			const ConnectionGraph::SignatureCache& sigCache =
+				ConnectionGraph::signatureCache();
+			FA_DEBUG_AT(1, "signature cache answered " << sigCache.hits()
+				<< " of " << sigCache.queries() << " signature computation(s)");
+
+			if (0 != resumptions_)
+			{
+				FA_DEBUG_AT(1, "the analysis has been resumed " << resumptions_
+					<< " time(s) instead of restarted, keeping " << statesKept_
+					<< " evaluated state(s)");
+			}
 		}
 		catch (const ProgramError& e)
 		{ }
@@ -626,6 +893,9 @@ public:   // methods
 
 			throw;
 		}
+
+		// the learnt boxes are valid even if an error has been found
+		this->storeBoxes();
 	}
 
 	void run(const Compiler::Assembly& assembly)
@@ -683,11 +953,13 @@ void SymExec::loadTypes(const CodeStorage::Storage& stor)
 	this->engine->loadTypes(stor);
 }
 
-#if 0
-void SymExec::loadBoxes(const std::unordered_map<std::string, std::string>& db) {
-	this->engine->loadBoxes(db);
+void SymExec::loadBoxes()
+{
+	// Assertions
+	assert(engine != nullptr);
+
+	this->engine->loadBoxes();
 }
-#endif
 
 const Compiler::Assembly& SymExec::GetAssembly() const
 {
@@ -77,7 +77,14 @@ public:   // methods
 	 */
 	void loadTypes(const CodeStorage::Storage& stor);
 
-//	void loadBoxes(const std::unordered_map<std::string, std::string>& db);
+	/**
+	 * @brief  Loads boxes from the persistent box database
+	 *
+	 * Loads boxes learnt in previous runs from the database in the directory
+	 * given by the @p db-root argument. The types need to be loaded first by
+	 * the method @p loadTypes.
+	 */
+	void loadBoxes();
 
 
 	/**
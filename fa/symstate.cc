@@ -121,24 +121,25 @@ void SymState::recycle(Recycler<SymState>& recycler)
 		this->GetParent()->removeChild(this);
 	}
 
-	std::vector<SymState*> stack = { this };
+	std::vector<SymState*> branch = { this };
 
-	while (!stack.empty())
-	{ // recycle recursively all children
-		SymState* state = stack.back();
-		stack.pop_back();
+	for (size_t i = 0; i < branch.size(); ++i)
+	{ // collect recursively all children
+		SymState* state = branch[i];
 
 		assert(state->GetFAE());
 		state->fae_ = nullptr;
 
 		for (auto s : state->GetChildren())
 		{
-			stack.push_back(static_cast<SymState*>(s));
+			branch.push_back(static_cast<SymState*>(s));
 		}
 
 		state->clearChildren();
-		recycler.recycle(state);
 	}
+
+	// recycle the whole branch at once
+	recycler.recycleAll(branch);
 }
 
 
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ta_bench.cc
+ * Benchmark of the storage of transitions of tree automata
+ *
+ * Compares traversals of the transition set of TA (with lazily built hash
+ * indices) with traversals of the flat sorted FlatTA view.  The input are
+ * Timbuk files, e.g. the fixpoints of forester-regre tests obtained by
+ * running forester with the "dump-fixpoints:<file>" argument.
+ *
+ * Usage: ta_bench [-n ROUNDS] FILE...
+ */
+
+// Standard library headers
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Forester headers
+#include "flattreeaut.hh"
+#include "tatimint.hh"
+#include "treeaut.hh"
+
+namespace {
+
+typedef TA<std::string> StrTA;
+typedef std::chrono::steady_clock Clock;
+
+/// sum of the states visited (keeps the traversals from being optimized out)
+size_t sink;
+
+/// top-down traversal using the hash index built by TA::buildTDCache()
+void tdCache(const StrTA& ta)
+{
+	const StrTA::td_cache_type cache = ta.buildTDCache();
+	for (const auto& stateTransPair : cache)
+	{
+		for (const StrTA::Transition* trans : stateTransPair.second)
+		{
+			for (size_t state : trans->lhs())
+				sink += state;
+		}
+	}
+}
+
+/// bottom-up traversal using the hash index built by TA::buildBUCache()
+void buCache(const StrTA& ta)
+{
+	StrTA::bu_cache_type cache;
+	ta.buildBUCache(cache);
+	for (const auto& stateTransPair : cache)
+	{
+		for (const StrTA::Transition* trans : stateTransPair.second)
+			sink += trans->rhs();
+	}
+}
+
+/// top-down traversal of the flat view (including its construction)
+void tdFlat(const StrTA& ta)
+{
+	const FlatTA<std::string> flat(ta);
+	for (size_t s = 0; s < flat.stateCount(); ++s)
+	{
+		const std::pair<size_t, size_t> range = flat.tdRange(s);
+		for (size_t i = range.first; i != range.second; ++i)
+		{
+			for (FlatTA<std::string>::range_type lhs = flat.lhs(i);
+				lhs.first != lhs.second; ++lhs.first)
+			{
+				sink += *lhs.first;
+			}
+		}
+	}
+}
+
+/// bottom-up traversal of the flat view (including its construction)
+void buFlat(const StrTA& ta)
+{
+	const FlatTA<std::string> flat(ta);
+	for (size_t s = 0; s < flat.stateCount(); ++s)
+	{
+		for (FlatTA<std::string>::range_type range = flat.buRange(s);
+			range.first != range.second; ++range.first)
+		{
+			sink += flat.rhs(*range.first);
+		}
+	}
+}
+
+/// removal of transitions subsumed w.r.t. the identity (uses FlatTA)
+void sieve(const StrTA& ta)
+{
+	Index<size_t> stateIndex;
+	ta.buildSortedStateIndex(stateIndex);
+	StrTA::Backend backend;
+	StrTA dst(backend);
+	ta.downwardSieve(dst, BitMatrix::identity(stateIndex.size()), stateIndex);
+	sink += dst.getTransitions().size();
+}
+
+/// runs @p f on all automata @p rounds times, returns the time in ms
+template <class F>
+double measure(const std::vector<StrTA>& automata, size_t rounds, F f)
+{
+	const Clock::time_point start = Clock::now();
+	for (size_t i = 0; i < rounds; ++i)
+	{
+		for (const StrTA& ta : automata)
+			f(ta);
+	}
+
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	size_t rounds = 100;
+	int first = 1;
+	if ((argc > 2) && (0 == std::strcmp(argv[1], "-n")))
+	{
+		rounds = std::strtoul(argv[2], nullptr, 10);
+		first = 3;
+	}
+
+	if (first >= argc)
+	{
+		std::cerr << "Usage: " << argv[0] << " [-n ROUNDS] FILE..." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	StrTA::Backend backend;
+	std::vector<StrTA> automata;
+	size_t transitions = 0;
+	for (int i = first; i < argc; ++i)
+	{
+		std::ifstream input(argv[i]);
+		if (!input)
+		{
+			std::cerr << "unable to open " << argv[i] << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		TAMultiReader reader(backend, input, argv[i]);
+		reader.read();
+		for (const StrTA& ta : reader.automata)
+		{
+			transitions += ta.getTransitions().size();
+			automata.push_back(ta);
+		}
+	}
+
+	std::cout << automata.size() << " automata, " << transitions
+		<< " transitions, " << rounds << " rounds" << std::endl;
+
+	const struct
+	{
+		const char* name;
+		void (*f)(const StrTA&);
+	} benchmarks[] = {
+		{ "top-down (hash index)",    tdCache },
+		{ "top-down (flat)",          tdFlat  },
+		{ "bottom-up (hash index)",   buCache },
+		{ "bottom-up (flat)",         buFlat  },
+		{ "downward sieve (flat)",    sieve   },
+	};
+
+	for (const auto& bench : benchmarks)
+	{
+		std::cout << std::setw(26) << std::left << bench.name
+			<< std::setw(10) << std::right << std::fixed << std::setprecision(2)
+			<< measure(automata, rounds, bench.f) << " ms" << std::endl;
+	}
+
+	return (sink) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -68,7 +68,7 @@ struct LhsEnv
 	static bool sim(
 		const LhsEnv&                              e1,
 		const LhsEnv&                              e2,
-		const std::vector<std::vector<bool>>&      sim)
+		const BitMatrix&                           sim)
 	{
 		if ((e1.index != e2.index) || (e1.data.size() != e2.data.size()))
 			return false;
@@ -85,7 +85,7 @@ struct LhsEnv
 	static bool eq(
 		const LhsEnv&                           e1,
 		const LhsEnv&                           e2,
-		const std::vector<std::vector<bool>>&   sim)
+		const BitMatrix&                        sim)
 	{
 		if ((e1.index != e2.index) || (e1.data.size() != e2.data.size()))
 			return false;
@@ -173,7 +173,7 @@ struct Env
 	static bool sim(
 		const Env&                              e1,
 		const Env&                              e2,
-		const std::vector<std::vector<bool>>&   sim)
+		const BitMatrix&                        sim)
 	{
 		return (e1.label == e2.label) && LhsEnv::sim(*e1.lhs, *e2.lhs, sim);
 	}
@@ -181,7 +181,7 @@ struct Env
 	static bool eq(
 		const Env&                              e1,
 		const Env&                              e2,
-		const std::vector<std::vector<bool>>&   sim)
+		const BitMatrix&                        sim)
 	{
 		return (e1.label == e2.label) && LhsEnv::eq(*e1.lhs, *e2.lhs, sim);
 	}
@@ -230,29 +230,206 @@ void TA<T>::downwardTranslation(
 }
 
 
+template <class T>
+void TA<T>::buildStateTrans(
+	state_trans_type&                 dst) const
+{
+	dst.clear();
+	for (const TransIDPair* ptrTransIDPair : this->transitions)
+	{
+		const Transition& trans = ptrTransIDPair->first;
+		dst[trans.rhs()].push_back(std::make_pair(trans.label(), trans.lhs()));
+	}
+
+	for (typename state_trans_type::iterator i = dst.begin(); i != dst.end(); ++i)
+		std::sort(i->second.begin(), i->second.end());
+}
+
+template <class T>
+bool TA<T>::incrementalDownwardSimulation(
+	BitMatrix&                        rel,
+	const Index<size_t>&              stateIndex,
+	const state_trans_type&           stateTrans,
+	const SimulationCache&            cache) const
+{
+	if (cache.trans.empty())
+		return false;
+
+	const size_t size = stateIndex.size();
+
+	// transitions with translated states, parents of each state and the rows
+	// of the states in the cached relation
+	std::vector<std::vector<std::pair<T, std::vector<size_t>>>> trans(size);
+	std::vector<std::vector<size_t>> parents(size);
+	std::vector<size_t> oldRow(size);
+
+	// states whose downward simulation may differ from the cached one
+	std::vector<size_t> affected;
+	std::vector<bool> isAffected(size, false);
+
+	for (Index<size_t>::iterator i = stateIndex.begin(); i != stateIndex.end(); ++i)
+	{
+		const size_t state = i->second;
+		typename state_trans_type::const_iterator cur = stateTrans.find(i->first);
+		typename state_trans_type::const_iterator old = cache.trans.find(i->first);
+		const std::pair<size_t, bool> row = cache.index.find(i->first);
+
+		oldRow[state] = row.first;
+		const bool curEmpty = (stateTrans.end() == cur);
+		const bool oldEmpty = (cache.trans.end() == old);
+		if (!row.second || (curEmpty != oldEmpty) ||
+			(!curEmpty && (cur->second != old->second)))
+		{
+			isAffected[state] = true;
+			affected.push_back(state);
+		}
+
+		if (curEmpty)
+			continue;
+
+		for (const std::pair<T, std::vector<size_t>>& t : cur->second)
+		{
+			std::vector<size_t> lhs;
+			stateIndex.translate(lhs, t.second);
+			for (size_t s : lhs)
+				parents[s].push_back(state);
+
+			trans[state].push_back(std::make_pair(t.first, lhs));
+		}
+	}
+
+	// the change propagates to all states above the modified ones
+	for (size_t k = 0; k < affected.size(); ++k)
+	{
+		for (size_t p : parents[affected[k]])
+		{
+			if (!isAffected[p])
+			{
+				isAffected[p] = true;
+				affected.push_back(p);
+			}
+		}
+	}
+
+	if (2 * affected.size() > size)
+	{	// not worth it, recompute from scratch
+		return false;
+	}
+
+	// the sub-automata below unaffected states did not change, so neither did
+	// the simulation between them
+	rel.assign(size, true);
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (isAffected[i])
+			continue;
+
+		for (size_t j = 0; j < size; ++j)
+		{
+			if (!isAffected[j])
+				rel[i][j] = cache.rel[oldRow[i]][oldRow[j]];
+		}
+	}
+
+	// (i, j) stays in the relation iff each transition of i is matched by a
+	// transition of j with the same label and simulating left-hand side
+	auto simulates = [&rel, &trans](size_t i, size_t j) -> bool
+	{
+		for (const std::pair<T, std::vector<size_t>>& t1 : trans[i])
+		{
+			bool found = false;
+			for (const std::pair<T, std::vector<size_t>>& t2 : trans[j])
+			{
+				if ((t1.first != t2.first) || (t1.second.size() > t2.second.size()))
+					continue;
+
+				found = true;
+				for (size_t k = 0; k < t1.second.size(); ++k)
+				{
+					if (!rel[t1.second[k]][t2.second[k]])
+					{
+						found = false;
+						break;
+					}
+				}
+
+				if (found)
+					break;
+			}
+
+			if (!found)
+				return false;
+		}
+
+		return true;
+	};
+
+	// refine the pairs with an affected state (greatest fixpoint)
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (size_t a : affected)
+		{
+			for (size_t x = 0; x < size; ++x)
+			{
+				if (rel[a][x] && !simulates(a, x))
+				{
+					rel[a][x] = false;
+					changed = true;
+				}
+
+				if (rel[x][a] && !simulates(x, a))
+				{
+					rel[x][a] = false;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
 template <class T>
 void TA<T>::downwardSimulation(
-	std::vector<std::vector<bool>>&   rel,
-	const Index<size_t>&              stateIndex) const
+	BitMatrix&                        rel,
+	const Index<size_t>&              stateIndex,
+	SimulationCache*                  cache) const
 {
-	LTS lts;
-	Index<T> labelIndex;
-	this->buildLabelIndex(labelIndex);
-	this->downwardTranslation(lts, stateIndex, labelIndex);
-	OLRTAlgorithm alg(lts);
-	alg.init();
-	alg.run();
-	alg.buildRel(stateIndex.size(), rel);
+	state_trans_type stateTrans;
+	if (nullptr != cache)
+		this->buildStateTrans(stateTrans);
+
+	if ((nullptr == cache) ||
+		!this->incrementalDownwardSimulation(rel, stateIndex, stateTrans, *cache))
+	{
+		LTS lts;
+		Index<T> labelIndex;
+		this->buildLabelIndex(labelIndex);
+		this->downwardTranslation(lts, stateIndex, labelIndex);
+		OLRTAlgorithm alg(lts);
+		alg.init();
+		alg.run();
+		alg.buildRel(stateIndex.size(), rel);
+	}
+
+	if (nullptr != cache)
+	{
+		cache->trans.swap(stateTrans);
+		cache->index = stateIndex;
+		cache->rel = rel;
+	}
 }
 
 template <class T>
 void TA<T>::upwardTranslation(
 	LTS&                                    lts,
 	std::vector<std::vector<size_t>>&       part,
-	std::vector<std::vector<bool>>&         rel,
+	BitMatrix&                              rel,
 	const Index<size_t>&                    stateIndex,
 	const Index<T>&                         labelIndex,
-	const std::vector<std::vector<bool>>&   sim) const
+	const BitMatrix&                        sim) const
 {
 	std::set<LhsEnv> lhsEnvSet;
 	std::map<Env, size_t> envMap;
@@ -310,8 +487,7 @@ void TA<T>::upwardTranslation(
 		}
 	}
 
-	rel = std::vector<std::vector<bool>>(
-		part.size() + 2, std::vector<bool>(part.size() + 2, false));
+	rel.assign(part.size() + 2, false);
 
 	// 0 non-accepting, 1 accepting, 2 .. environments
 	rel[0][0] = true;
@@ -329,15 +505,15 @@ void TA<T>::upwardTranslation(
 
 template <class T>
 void TA<T>::upwardSimulation(
-	std::vector<std::vector<bool>>&         rel,
+	BitMatrix&                              rel,
 	const Index<size_t>&                    stateIndex,
-	const std::vector<std::vector<bool>>&   param) const
+	const BitMatrix&                        param) const
 {
 	LTS lts;
 	Index<T> labelIndex;
 	this->buildLabelIndex(labelIndex);
 	std::vector<std::vector<size_t>> part;
-	std::vector<std::vector<bool>> initRel;
+	BitMatrix initRel;
 	this->upwardTranslation(lts, part, initRel, stateIndex, labelIndex, param);
 	OLRTAlgorithm alg(lts);
 	// accepting states to block 1
@@ -355,42 +531,24 @@ void TA<T>::upwardSimulation(
 
 template <class T>
 void TA<T>::combinedSimulation(
-	std::vector<std::vector<bool>>&           dst,
-	const std::vector<std::vector<bool>>&     dwn,
-	const std::vector<std::vector<bool>>&     up)
+	BitMatrix&                                dst,
+	const BitMatrix&                          dwn,
+	const BitMatrix&                          up)
 {
 	size_t size = dwn.size();
-	std::vector<std::vector<bool> > dut(size, std::vector<bool>(size, false));
+	BitMatrix dut(size, false);
 	for (size_t i = 0; i < size; ++i)
 	{
 		for (size_t j = 0; j < size; ++j)
-		{
-			for (size_t k = 0; k < size; ++k)
-			{
-				if (dwn[i][k] && up[j][k])
-				{
-					dut[i][j] = true;
-					break;
-				}
-			}
-		}
+			dut[i][j] = dwn.rowIntersects(i, up, j);
 	}
 	dst = dut;
 	for (size_t i = 0; i < size; ++i)
 	{
 		for (size_t j = 0; j < size; ++j)
 		{
-			if (!dst[i][j])
-				continue;
-
-			for (size_t k = 0; k < size; ++k)
-			{
-				if (dwn[j][k] && !dut[i][k])
-				{
-					dst[i][j] = false;
-					break;
-				}
-			}
+			if (dst[i][j] && !dwn.rowSubsetOf(j, dut, i))
+				dst[i][j] = false;
 		}
 	}
 }
@@ -398,7 +556,7 @@ void TA<T>::combinedSimulation(
 template <class T>
 bool TA<T>::subseteq(const TA<T>& a, const TA<T>& b)
 {
-	return AntichainExt<T>::subseteq(a, b);
+	return inclusionCache().subseteq(a, b, &AntichainExt<T>::subseteq);
 }
 
 // this is really sad :-(
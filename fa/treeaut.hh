@@ -27,10 +27,15 @@
 #include <algorithm>
 #include <cassert>
 #include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 // Forester headers
 #include "cache.hh"
+#include "flattreeaut.hh"
 #include "lts.hh"
+#include "recycler.hh"
 #include "streams.hh"
 #include "utils.hh"
 
@@ -210,7 +215,7 @@ public:   // methods
 
 	bool llhsLessThan(
 		const TT&                                 rhs,
-		const std::vector<std::vector<bool>>&     cons,
+		const BitMatrix&                          cons,
 		const Index<size_t>&                      stateIndex) const
 	{
 		if (this->label() != rhs.label())
@@ -236,8 +241,9 @@ public:   // data types
 	///	the type of a tree automaton transition
 	typedef TT<T> Transition;
 
-	/// cache of transitions
-	typedef Cache<Transition> trans_cache_type;
+	/// cache of transitions (the nodes of its hash table are recycled)
+	typedef Cache<Transition, PoolAllocator<std::pair<const Transition, size_t>>>
+		trans_cache_type;
 
 	/// the value type of the cache: a pair of a transition and its ID
 	typedef std::pair<const Transition, size_t> TransIDPair;
@@ -247,6 +253,346 @@ public:   // data types
 		std::is_same<typename trans_cache_type::value_type, TransIDPair>::value,
 		"Incompatible types!");
 
+	struct Backend;
+
+	/**
+	 * @brief  Canonical fingerprint of a tree automaton
+	 *
+	 * The fingerprint consists of the sorted list of transitions (encoded by
+	 * value, i.e. independently of the addresses of cached objects) and the
+	 * sorted list of final states.  Two automata with equal fingerprints
+	 * therefore accept the same language.
+	 */
+	struct Fingerprint
+	{
+		/// a transition encoded as its label and the list [rhs, lhs...]
+		typedef std::pair<T, std::vector<size_t>> trans_type;
+
+		std::vector<trans_type> transitions;
+		std::vector<size_t> finalStates;
+		size_t hash;
+
+		explicit Fingerprint(const TA<T>& ta) :
+			transitions{},
+			finalStates(ta.finalStates_.begin(), ta.finalStates_.end()),
+			hash(0)
+		{
+			this->transitions.reserve(ta.transitions.size());
+			for (const TransIDPair* trans : ta.transitions)
+			{
+				std::vector<size_t> states(1, trans->first.rhs());
+				states.insert(states.end(),
+					trans->first.lhs().begin(), trans->first.lhs().end());
+				this->transitions.push_back(
+					trans_type(trans->first.label(), states));
+			}
+
+			this->computeHash();
+		}
+
+		bool operator==(const Fingerprint& rhs) const
+		{
+			return (this->hash == rhs.hash)
+				&& (this->finalStates == rhs.finalStates)
+				&& (this->transitions == rhs.transitions);
+		}
+
+		struct Hash
+		{
+			size_t operator()(const Fingerprint& fingerprint) const
+			{
+				return fingerprint.hash;
+			}
+		};
+
+	private:
+
+		void computeHash()
+		{
+			std::sort(this->transitions.begin(), this->transitions.end());
+
+			for (const trans_type& trans : this->transitions)
+			{
+				boost::hash_combine(this->hash, trans.first);
+				boost::hash_combine(this->hash, trans.second);
+			}
+
+			boost::hash_combine(this->hash, this->finalStates);
+		}
+	};
+
+	/**
+	 * @brief  Memoized results of language inclusion checks
+	 *
+	 * Results (both positive and negative) are stored separately for each
+	 * backend and dropped when the backend is destroyed.
+	 */
+	class InclusionCache
+	{
+	private:  // data types
+
+		typedef std::pair<Fingerprint, Fingerprint> key_type;
+
+		struct KeyHash
+		{
+			size_t operator()(const key_type& key) const
+			{
+				size_t h = key.first.hash;
+				boost::hash_combine(h, key.second.hash);
+				return h;
+			}
+		};
+
+		typedef std::unordered_map<key_type, bool, KeyHash> store_type;
+
+		/// maximal number of results remembered for a single backend
+		static const size_t MAX_ENTRIES = 4096;
+
+	private:  // data members
+
+		std::unordered_map<const Backend*, store_type> stores_;
+
+		size_t queries_;
+		size_t hits_;
+		size_t negativeHits_;
+
+		/// the cache is shared by all threads, the oracle runs unlocked
+		mutable std::mutex mutex_;
+
+	public:   // methods
+
+		InclusionCache() :
+			stores_{},
+			queries_(0),
+			hits_(0),
+			negativeHits_(0),
+			mutex_{}
+		{ }
+
+		/**
+		 * @brief  Checks L(a) <= L(b), using @p oracle on a cache miss
+		 */
+		template <class F>
+		bool subseteq(const TA<T>& a, const TA<T>& b, F oracle)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				++queries_;
+			}
+
+			if (a.backend != b.backend)
+				return oracle(a, b);
+
+			const key_type key{ Fingerprint(a), Fingerprint(b) };
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				const store_type& store = stores_[a.backend];
+				typename store_type::const_iterator it = store.find(key);
+				if (store.end() != it)
+				{
+					++hits_;
+					if (!it->second)
+						++negativeHits_;
+
+					return it->second;
+				}
+			}
+
+			const bool result = oracle(a, b);
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			store_type& store = stores_[a.backend];
+			if (store.size() >= MAX_ENTRIES)
+				store.clear();
+
+			store.insert(std::make_pair(key, result));
+			return result;
+		}
+
+		void invalidate(const Backend* backend)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stores_.erase(backend);
+		}
+
+		size_t queries() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return queries_;
+		}
+
+		size_t hits() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return hits_;
+		}
+
+		size_t negativeHits() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return negativeHits_;
+		}
+	};
+
+	/**
+	 * @brief  The store of canonical (shared) tree automata
+	 *
+	 * The store hash-conses tree automata: intern() returns the same instance
+	 * for all automata with equal fingerprints (as long as the instance
+	 * lives), so that equal components of forest automata are shared and can
+	 * be compared by their addresses. Instances returned by the store must not
+	 * be modified. Instances are stored separately for each backend and
+	 * dropped when the backend is destroyed.
+	 */
+	class CanonicalStore
+	{
+	private:  // data types
+
+		typedef std::unordered_map<Fingerprint, std::weak_ptr<TA<T>>,
+			typename Fingerprint::Hash> instance_type;
+
+		struct Store
+		{
+			/// live canonical instances
+			instance_type instances;
+
+			/// the number of instances at which the next sweep happens
+			size_t sweepAt;
+
+			Store() :
+				instances{},
+				sweepAt(MIN_SWEEP)
+			{ }
+		};
+
+		/// the minimal number of instances at which dead ones are swept out
+		static const size_t MIN_SWEEP = 1024;
+
+	private:  // data members
+
+		std::unordered_map<const Backend*, Store> stores_;
+
+		size_t shared_;
+
+		/// the store is shared by all threads
+		mutable std::mutex mutex_;
+
+	private:  // methods
+
+		/**
+		 * @brief  Returns the live instance equal to @p ta or makes @p ta one
+		 *
+		 * The mutex needs to be locked.
+		 */
+		std::shared_ptr<TA<T>> internLocked(
+			Store&                                 store,
+			const Fingerprint&                     fingerprint,
+			const std::shared_ptr<TA<T>>&          ta)
+		{
+			auto it = store.instances.find(fingerprint);
+			if (store.instances.end() != it)
+			{
+				std::shared_ptr<TA<T>> instance = it->second.lock();
+				if (instance)
+				{
+					++shared_;
+					return instance;
+				}
+
+				it->second = ta;
+				return ta;
+			}
+
+			if (store.instances.size() >= store.sweepAt)
+			{	// remove dead instances
+				for (it = store.instances.begin(); it != store.instances.end(); )
+				{
+					if (it->second.expired())
+						it = store.instances.erase(it);
+					else
+						++it;
+				}
+
+				store.sweepAt = std::max(static_cast<size_t>(MIN_SWEEP),
+					2 * store.instances.size());
+			}
+
+			store.instances.insert(std::make_pair(fingerprint, ta));
+			return ta;
+		}
+
+	public:   // methods
+
+		CanonicalStore() :
+			stores_{},
+			shared_(0),
+			mutex_{}
+		{ }
+
+		/**
+		 * @brief  Returns the canonical instance of @p ta
+		 */
+		std::shared_ptr<TA<T>> intern(const std::shared_ptr<TA<T>>& ta)
+		{
+			// Preconditions
+			assert(nullptr != ta);
+
+			const Fingerprint fingerprint(*ta);
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			return this->internLocked(stores_[ta->backend], fingerprint, ta);
+		}
+
+		void invalidate(const Backend* backend)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stores_.erase(backend);
+		}
+
+		/// the number of times an existing instance was returned
+		size_t shared() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return shared_;
+		}
+	};
+
+	/// transitions (label and left-hand side) leading to each state, sorted
+	typedef std::unordered_map<size_t, std::vector<std::pair<T, std::vector<size_t>>>>
+		state_trans_type;
+
+	/**
+	 * @brief  Downward simulation remembered from a previous computation
+	 *
+	 * Passing the same instance to subsequent calls of downwardSimulation()
+	 * allows to recompute only the part of the relation that may have been
+	 * changed by transitions added or removed since the previous call.
+	 */
+	struct SimulationCache
+	{
+		/// transitions of the automaton the relation was computed for
+		state_trans_type trans;
+
+		/// maps states to rows of @p rel
+		Index<size_t> index;
+
+		/// the downward simulation over the states in @p index
+		BitMatrix rel;
+
+		SimulationCache() :
+			trans{},
+			index{},
+			rel{}
+		{ }
+
+		void clear()
+		{
+			this->trans.clear();
+			this->index.clear();
+			this->rel.assign(0, false);
+		}
+	};
+
 	// this is the place where transitions are stored
 	struct Backend
 	{
@@ -257,6 +603,21 @@ public:   // data types
 			lhsCache{},
 			transCache{}
 		{ }
+
+		~Backend()
+		{
+			TA<T>::inclusionCache().invalidate(this);
+			TA<T>::canonicalStore().invalidate(this);
+		}
+
+		/**
+		 * @brief  Allows automata of the backend to be used by several threads
+		 */
+		void setConcurrent(bool concurrent)
+		{
+			this->lhsCache.setConcurrent(concurrent);
+			this->transCache.setConcurrent(concurrent);
+		}
 	};
 
 	struct CmpF
@@ -813,27 +1174,37 @@ public:
 		const Index<size_t>&                      stateIndex,
 		const Index<T>&                           labelIndex) const;
 
+	void buildStateTrans(
+		state_trans_type&                         dst) const;
+
+	bool incrementalDownwardSimulation(
+		BitMatrix&                                rel,
+		const Index<size_t>&                      stateIndex,
+		const state_trans_type&                   stateTrans,
+		const SimulationCache&                    cache) const;
+
 	void downwardSimulation(
-		std::vector<std::vector<bool>>&           rel,
-		const Index<size_t>&                      stateIndex) const;
+		BitMatrix&                                rel,
+		const Index<size_t>&                      stateIndex,
+		SimulationCache*                          cache = nullptr) const;
 
 	void upwardTranslation(
 		LTS&                                      lts,
 		std::vector<std::vector<size_t>>&         part,
-		std::vector<std::vector<bool>>&           rel,
+		BitMatrix&                                rel,
 		const Index<size_t>&                      stateIndex,
 		const Index<T>&                           labelIndex,
-		const std::vector<std::vector<bool>>&     sim) const;
+		const BitMatrix&                          sim) const;
 
 	void upwardSimulation(
-		std::vector<std::vector<bool>>&           rel,
+		BitMatrix&                                rel,
 		const Index<size_t>&                      stateIndex,
-		const std::vector<std::vector<bool>>&     param) const;
+		const BitMatrix&                          param) const;
 
 	static void combinedSimulation(
-		std::vector<std::vector<bool>>&           dst,
-		const std::vector<std::vector<bool>>&     dwn,
-		const std::vector<std::vector<bool>>&     up);
+		BitMatrix&                                dst,
+		const BitMatrix&                          dwn,
+		const BitMatrix&                          up);
 
 	template <class F>
 	static size_t buProduct(
@@ -988,7 +1359,7 @@ public:
 		const Transition*                         t1,
 		const Transition*                         t2,
 		F                                         funcMatch,
-		const std::vector<std::vector<bool>>&     mat,
+		const BitMatrix&                          mat,
 		const Index<size_t>&                      stateIndex)
 	{
 		// Preconditions
@@ -1015,48 +1386,69 @@ public:
 	// currently erases '1' from the relation
 	template <class F>
 	void heightAbstraction(
-		std::vector<std::vector<bool>>&            result,
+		BitMatrix&                                 result,
 		size_t                                     height,
 		F                                          f,
 		const Index<size_t>&                       stateIndex) const
 	{
-		td_cache_type cache = this->buildTDCache();
+		const FlatTA<T> flat(*this);
+
+		// rows of the dense states of 'flat' in the relation
+		std::vector<size_t> row(flat.stateCount());
+		for (size_t s = 0; s < flat.stateCount(); ++s)
+			row[s] = stateIndex[flat.state(s)];
+
+		// transitions of each state of the relation
+		std::vector<std::pair<size_t, size_t>> trans(
+			stateIndex.size(), std::pair<size_t, size_t>(0, 0));
+		for (Index<size_t>::iterator i = stateIndex.begin(); i != stateIndex.end(); ++i)
+		{
+			if (flat.hasState(i->first))
+				trans[i->second] = flat.tdRange(flat.find(i->first));
+		}
+
+		BitMatrix tmp;
+
+		auto match = [&flat, &row, &tmp, &f](size_t t1, size_t t2) -> bool
+		{
+			if (!f(flat.orig(t1), flat.orig(t2)) || (flat.lhsSize(t1) != flat.lhsSize(t2)))
+				return false;
+
+			typename FlatTA<T>::range_type l1 = flat.lhs(t1), l2 = flat.lhs(t2);
+			for ( ; l1.first != l1.second; ++l1.first, ++l2.first)
+			{
+				if (!tmp[row[*l1.first]][row[*l2.first]])
+					return false;
+			}
 
-		std::vector<std::vector<bool>> tmp;
+			return true;
+		};
 
 		while (height--)
 		{
 			tmp = result;
 
-			for (Index<size_t>::iterator i = stateIndex.begin(); i != stateIndex.end(); ++i)
+			for (size_t state1 = 0; state1 < trans.size(); ++state1)
 			{
-				const size_t& state1 = i->second;
-				typename td_cache_type::iterator j = cache.insert(
-					std::make_pair(i->first, std::vector<const Transition*>())
-				).first;
-				for (Index<size_t>::iterator k = stateIndex.begin(); k != stateIndex.end(); ++k)
+				for (size_t state2 = 0; state2 < trans.size(); ++state2)
 				{
-					const size_t& state2 = k->second;
 					if ((state1 == state2) || !tmp[state1][state2])
 						continue;
-					typename td_cache_type::iterator l = cache.insert(
-						std::make_pair(k->first, std::vector<const Transition*>())
-					).first;
-					bool match = true;
-					for (const Transition* trans1 : j->second)
+
+					bool matches = true;
+					for (size_t t1 = trans[state1].first; matches && (t1 != trans[state1].second); ++t1)
 					{
-						for (const Transition* trans2 : l->second)
+						for (size_t t2 = trans[state2].first; t2 != trans[state2].second; ++t2)
 						{
-							if (!TA<T>::transMatch(trans1, trans2, f, tmp, stateIndex))
+							if (!match(t1, t2))
 							{
-								match = false;
+								matches = false;
 								break;
 							}
 						}
-						if (!match)
-							break;
 					}
-					if (!match)
+
+					if (!matches)
 						result[state1][state2] = false;
 				}
 			}
@@ -1075,7 +1467,7 @@ public:
 	}
 
 	void predicateAbstraction(
-		std::vector<std::vector<bool>>&      result,
+		BitMatrix&                           result,
 		const TA<T>&                         predicate,
 		const Index<size_t>&                 stateIndex) const
 	{
@@ -1104,7 +1496,7 @@ public:
 	// collapses states according to a given relation
 	TA<T>& collapsed(
 		TA<T>&                                   dst,
-		const std::vector<std::vector<bool>>&    rel,
+		const BitMatrix&                         rel,
 		const Index<size_t>&                     stateIndex) const
 	{
 		std::vector<size_t> headIndex;
@@ -1288,51 +1680,73 @@ public:
 
 	TA<T>& downwardSieve(
 		TA<T>&                                    dst,
-		const std::vector<std::vector<bool>>&     cons,
+		const BitMatrix&                          cons,
 		const Index<size_t>&                      stateIndex) const
 	{
-		td_cache_type cache = this->buildTDCache();
+		const FlatTA<T> flat(*this);
+
+		// rows of the dense states of 'flat' in the relation
+		std::vector<size_t> row(flat.stateCount());
+		for (size_t s = 0; s < flat.stateCount(); ++s)
+			row[s] = stateIndex[flat.state(s)];
+
+		// the left-hand side of t1 is less than the one of t2 (w.r.t. 'cons')
+		auto llhsLessThan = [&flat, &row, &cons](size_t t1, size_t t2) -> bool
+		{
+			if ((flat.label(t1) != flat.label(t2)) || (flat.lhsSize(t1) != flat.lhsSize(t2)))
+				return false;
+
+			typename FlatTA<T>::range_type l1 = flat.lhs(t1), l2 = flat.lhs(t2);
+			for ( ; l1.first != l1.second; ++l1.first, ++l2.first)
+			{
+				if (!cons[row[*l1.first]][row[*l2.first]])
+					return false;
+			}
+
+			return true;
+		};
 
 		for (size_t state : finalStates_)
 			dst.addFinalState(state);
 
-		for (typename td_cache_type::iterator i = cache.begin(); i != cache.end(); ++i)
+		std::vector<size_t> tmp;
+		for (size_t s = 0; s < flat.stateCount(); ++s)
 		{
-			std::list<const Transition*> tmp;
-			for (typename std::vector<const Transition*>::iterator j = i->second.begin(); j != i->second.end(); ++j)
+			tmp.clear();
+			const std::pair<size_t, size_t> range = flat.tdRange(s);
+			for (size_t j = range.first; j != range.second; ++j)
 			{
 				bool noskip = true;
-				for (typename std::list<const Transition*>::iterator k = tmp.begin(); k != tmp.end(); )
+				for (size_t k = 0; k < tmp.size(); )
 				{
-					if ((*j)->llhsLessThan(**k, cons, stateIndex))
+					if (llhsLessThan(j, tmp[k]))
 					{
 						noskip = false;
 						break;
 					}
-					if ((*k)->llhsLessThan(**j, cons, stateIndex))
-					{
-						typename std::list<const Transition*>::iterator l = k++;
-						tmp.erase(l);
-					} else ++k;
+					if (llhsLessThan(tmp[k], j))
+						tmp.erase(tmp.begin() + k);
+					else ++k;
 				}
 				if (noskip)
-					tmp.push_back(*j);
+					tmp.push_back(j);
 			}
-			for (typename std::list<const Transition*>::iterator j = tmp.begin(); j != tmp.end(); ++j)
-				dst.addTransition(**j);
+			for (size_t j : tmp)
+				dst.addTransition(flat.orig(j));
 		}
 		return dst;
 	}
 
 	TA<T>& minimized(
 		TA<T>&                                   dst,
-		const std::vector<std::vector<bool>>&    cons,
-		const Index<size_t>&                     stateIndex) const
+		const BitMatrix&                         cons,
+		const Index<size_t>&                     stateIndex,
+		SimulationCache*                         cache = nullptr) const
 	{
 		typename TA<T>::Backend backend;
-		std::vector<std::vector<bool>> dwn;
-		this->downwardSimulation(dwn, stateIndex);
-		utils::relAnd(dwn, cons, dwn);
+		BitMatrix dwn;
+		this->downwardSimulation(dwn, stateIndex, cache);
+		dwn &= cons;
 		TA<T> tmp1(backend), tmp2(backend), tmp3(backend);
 		return this->collapsed(tmp1, dwn, stateIndex).uselessFree(tmp2).downwardSieve(tmp3, dwn, stateIndex).unreachableFree(dst);
 	}
@@ -1342,26 +1756,55 @@ public:
 		Index<size_t> stateIndex;
 		this->buildSortedStateIndex(stateIndex);
 		typename TA<T>::Backend backend;
-		std::vector<std::vector<bool> > dwn;
+		BitMatrix dwn;
 		this->downwardSimulation(dwn, stateIndex);
-		std::vector<std::vector<bool> > up;
+		BitMatrix up;
 		this->upwardSimulation(up, stateIndex, dwn);
-		std::vector<std::vector<bool> > rel;
+		BitMatrix rel;
 		TA<T>::combinedSimulation(rel, dwn, up);
 		TA<T> tmp(backend);
 		return this->collapsed(tmp, rel, stateIndex).minimized(dst);
 	}
 
-	TA<T>& minimized(TA<T>& dst) const
+	/**
+	 * @brief  Minimizes the automaton using downward simulation
+	 *
+	 * If @p cache is given, the simulation is computed incrementally with
+	 * respect to the automaton minimized last time with the same @p cache.
+	 */
+	TA<T>& minimized(TA<T>& dst, SimulationCache* cache = nullptr) const
 	{
 		Index<size_t> stateIndex;
 		this->buildSortedStateIndex(stateIndex);
-		std::vector<std::vector<bool> > cons(stateIndex.size(), std::vector<bool>(stateIndex.size(), true));
-		return this->minimized(dst, cons, stateIndex);
+		BitMatrix cons(stateIndex.size(), true);
+		return this->minimized(dst, cons, stateIndex, cache);
 	}
 
+	/**
+	 * @brief  Checks language inclusion L(a) <= L(b)
+	 *
+	 * Results are memoized in the global inclusion cache.
+	 */
 	static bool subseteq(const TA<T>& a, const TA<T>& b);
 
+	/**
+	 * @brief  The global cache of results of language inclusion checks
+	 */
+	static InclusionCache& inclusionCache()
+	{
+		static InclusionCache cache;
+		return cache;
+	}
+
+	/**
+	 * @brief  The global store of canonical tree automata
+	 */
+	static CanonicalStore& canonicalStore()
+	{
+		static CanonicalStore store;
+		return store;
+	}
+
 
 	/**
 	 * @brief  Creates a new TA with renamed states
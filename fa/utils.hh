@@ -28,6 +28,9 @@
 #include <unordered_set>
 #include <vector>
 
+// Forester headers
+#include "bitmatrix.hh"
+
 template <class T>
 struct Index
 {
@@ -313,7 +316,7 @@ public:
 	 *                        with the index of the first equivalent element
 	 */
 	static void relBuildClasses(
-		const std::vector<std::vector<bool>>&        rel,
+		const BitMatrix&                             rel,
 		std::vector<size_t>&                         headIndex)
 	{
 		headIndex.resize(rel.size());
@@ -368,35 +371,6 @@ public:
 	}
 #endif
 
-	// and composition
-	static void relAnd(std::vector<std::vector<bool> >& dst, const std::vector<std::vector<bool> >& src1, const std::vector<std::vector<bool> >& src2) {
-		dst.resize(src1.size(), std::vector<bool>(src1.size()));
-		for (size_t i = 0; i < src1.size(); ++i) {
-			for (size_t j = 0; j < src1.size(); ++j)
-				dst[i][j] = src1[i][j] && src2[i][j];
-		}
-	}
-
-	// transposition
-	static void relInv(std::vector<std::vector<bool> >& dst, const std::vector<std::vector<bool> >& src) {
-		dst.resize(src.size(), std::vector<bool>(src.size()));
-		for (size_t i = 0; i < src.size(); ++i) {
-			for (size_t j = 0; j < src.size(); ++j)
-				dst[j][i] = src[i][j];
-		}
-	}
-
-	// relation index
-	static void relIndex(std::vector<std::vector<size_t> >& dst, const std::vector<std::vector<bool> >& src) {
-		dst.resize(src.size());
-		for (size_t i = 0; i < src.size(); ++i) {
-			for (size_t j = 0; j < src.size(); ++j) {
-				if (src[i][j])
-					dst[i].push_back(j);
-			}
-		}
-	}
-
 	// intersection	
 	template <class T1, class T2>
 	static bool checkIntersection(const T1& x, const T2& y) {
@@ -472,16 +446,6 @@ public:
 		return true;
 	}
 
-	// print
-	static std::ostream& relPrint(std::ostream& os, const std::vector<std::vector<bool> >& src) {
-		for (size_t i = 0; i < src.size(); ++i) {
-			for (size_t j = 0; j < src.size(); ++j)
-				os << src[i][j];
-			os << std::endl;
-		}
-		return os;
-	}
-
 	template <class T>
 	static std::ostream& printCont(std::ostream& os, const T& container) {
 		os << '{';
@@ -835,13 +835,18 @@ namespace CallGraph {
         /// insns that take address of this function, zero key means initializer
         TInsnListByFnc              callbacks;
 
+        /// index of the strongly connected component in Graph::sccs (or -1)
+        int                         scc;
+
         Node(Fnc *fnc_):
-            fnc(fnc_)
+            fnc(fnc_),
+            scc(-1)
         {
         }
     };
 
     typedef std::set<Node *>                        TNodeList;
+    typedef std::vector<TFncList>                   TSccList;
 
     struct Graph {
         TNodeList                   roots;
@@ -852,9 +857,13 @@ namespace CallGraph {
 
         TFncList                    topOrder;
 
+        /// strongly connected components in bottom-up order (callees first)
+        TSccList                    sccs;
+
         Graph():
             hasIndirectCall(false),
-            hasCallback(false)
+            hasCallback(false),
+            sccs()
         {
         }
     };
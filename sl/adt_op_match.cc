@@ -27,7 +27,8 @@
 #include <cl/cl_msg.hh>
 #include <cl/storage.hh>            // for CodeStorage::TypeDb::dataPtrSizeof()
 
-#include <algorithm>                // for std::reverse
+#include <algorithm>                // for std::max, std::reverse
+#include <map>
 
 #include <boost/foreach.hpp>
 
@@ -47,12 +48,88 @@ typedef FixedPoint::THeapIdx                        THeapIdx;
 typedef FixedPoint::THeapIdent                      THeapIdent;
 typedef FixedPoint::TShapeIdent                     TShapeIdent;
 
+unsigned countObjects(const SymHeap &sh)
+{
+    TObjList objs;
+    sh.gatherObjects(objs);
+    return objs.size();
+}
+
+/// cheap invariants of a footprint checked before its anchor heap is matched
+struct FootprintIndex {
+    bool                            valid;
+    unsigned                        anchorLength;
+
+    FootprintIndex():
+        valid(false),
+        anchorLength(0U)
+    {
+    }
+};
+
+typedef std::vector<FootprintIndex>                 TFootprintIndexList;
+typedef std::vector<TFootprintIndexList>            TFootprintIndexByTpl;
+
+void indexFootprint(
+        FootprintIndex             *pDst,
+        const OpTemplate           &tpl,
+        const TFootprintIdx         idx)
+{
+    const bool reverse = (SD_BACKWARD == tpl.searchDirection());
+    const OpFootprint &fp = tpl[idx];
+    const SymHeap &shTpl = (reverse)
+        ? fp.output
+        : fp.input;
+    const TShapeListByHeapIdx &csTplListByIdx = (reverse)
+        ? tpl.outShapes()
+        : tpl.inShapes();
+
+    const TShapeList &csTplList = csTplListByIdx[idx];
+    if (1U != csTplList.size()) {
+        CL_BREAK_IF("unsupported count of shapes in indexFootprint()");
+        return;
+    }
+
+    const Shape &csTpl = csTplList.front();
+    if (csTpl.length != countObjects(shTpl)) {
+        CL_BREAK_IF("unsupported anchor heap in a template");
+        return;
+    }
+
+    pDst->valid = true;
+    pDst->anchorLength = csTpl.length;
+}
+
+typedef std::pair<THeapIdent, THeapIdent>           THeapPair;
+
+/// result of diffHeaps() on a pair of neighbouring heaps in the fixed-point
+struct HeapPairDiff {
+    bool                            ok;
+    TMetaOpSet                      metaOps;
+
+    HeapPairDiff():
+        ok(false)
+    {
+    }
+};
+
+typedef std::map<THeapPair, HeapPairDiff>           THeapPairDiffMap;
+
 struct MatchCtx {
     TMatchList                     &matchList;
     const OpCollection             &opCollection;
     const TProgState               &progState;
     FixedPoint::TShapeSeqList       shapeSeqs;
 
+    /// the longest container shape in each of shapeSeqs
+    std::vector<unsigned>           maxLengthBySeq;
+
+    /// invariants of all footprints, indexed by TFootprintIdent
+    TFootprintIndexByTpl            fpIndex;
+
+    /// diffs of heap pairs are shared by all the templates being matched
+    THeapPairDiffMap                diffByHeapPair;
+
     MatchCtx(
             TMatchList             &matchList_,
             const OpCollection     &opCollection_,
@@ -62,16 +139,29 @@ struct MatchCtx {
         progState(progState_)
     {
         FixedPoint::collectShapeSequences(&shapeSeqs, progState);
+
+        BOOST_FOREACH(const FixedPoint::TShapeSeq &seq, shapeSeqs) {
+            unsigned maxLength = 0U;
+            BOOST_FOREACH(const TShapeIdent &shIdent, seq) {
+                const Shape &cs = *shapeByIdent(progState, shIdent);
+                maxLength = std::max(maxLength, cs.length);
+            }
+
+            maxLengthBySeq.push_back(maxLength);
+        }
+
+        const TTemplateIdx tplCnt = opCollection.size();
+        fpIndex.resize(tplCnt);
+        for (TTemplateIdx tplIdx = 0; tplIdx < tplCnt; ++tplIdx) {
+            const OpTemplate &tpl = opCollection[tplIdx];
+            const TFootprintIdx fpCnt = tpl.size();
+            fpIndex[tplIdx].resize(fpCnt);
+            for (TFootprintIdx fpIdx = 0; fpIdx < fpCnt; ++fpIdx)
+                indexFootprint(&fpIndex[tplIdx][fpIdx], tpl, fpIdx);
+        }
     }
 };
 
-unsigned countObjects(const SymHeap &sh)
-{
-    TObjList objs;
-    sh.gatherObjects(objs);
-    return objs.size();
-}
-
 enum EContext {
     C_TEMPLATE,
     C_PROGRAM,
@@ -211,11 +301,6 @@ bool matchAnchorHeapCore(
         const Shape                &csProg,
         const Shape                &csTpl)
 {
-    if (csTpl.length != countObjects(shTpl)) {
-        CL_BREAK_IF("unsupported anchor heap in a template");
-        return false;
-    }
-
     // resolve list of objects belonging to containers shapes
     TObjList objLists[C_TOTAL];
     objListByShape(&objLists[C_TEMPLATE], shTpl, csTpl);
@@ -294,12 +379,9 @@ bool matchAnchorHeap(
         ? tpl.outShapes()
         : tpl.inShapes();
 
-    // check the count of container shapes in the template
+    // the count of container shapes in the template is checked by MatchCtx
     const TShapeList &csTplList = csTplListByIdx[fpIdent./* footprint */second];
-    if (1U != csTplList.size()) {
-        CL_BREAK_IF("unsupported count of shapes in matchAnchorHeap()");
-        return false;
-    }
+    CL_BREAK_IF(1U != csTplList.size());
 
     // resolve objMap by search direction
     const EFootprintPort port = (reverse)
@@ -616,23 +698,49 @@ bool isIndependentOp(
     return true;
 }
         
+/// return the (cached) difference of the pair of heaps, 0 if diffHeaps() fails
+const TMetaOpSet* diffOfHeapPair(
+        MatchCtx                   &ctx,
+        const THeapIdent            heap0,
+        const THeapIdent            heap1)
+{
+    const THeapPair key(heap0, heap1);
+    THeapPairDiffMap::iterator it = ctx.diffByHeapPair.find(key);
+    if (ctx.diffByHeapPair.end() == it) {
+        // compute the difference of the pair of heaps
+        const SymHeap &sh0 = *heapByIdent(ctx.progState, heap0);
+        const SymHeap &sh1 = *heapByIdent(ctx.progState, heap1);
+        const HeapPairDiff empty;
+        it = ctx.diffByHeapPair.insert(std::make_pair(key, empty)).first;
+        HeapPairDiff &diff = it->second;
+        diff.ok = diffHeaps(&diff.metaOps, sh0, sh1);
+    }
+
+    const HeapPairDiff &diff = it->second;
+    if (!diff.ok) {
+        TM_DEBUG("diffHeaps() has failed");
+        return 0;
+    }
+
+    return &diff.metaOps;
+}
+
 bool processDiffOf(
         FootprintMatch             *pMatch,
         TMetaOpSet                 *pLookup,
-        const TProgState           &progState,
+        MatchCtx                   &ctx,
         const THeapIdent            heap0,
         const THeapIdent            heap1,
         const ESearchDirection      sd)
 {
-    const SymHeap &sh0 = *heapByIdent(progState, heap0);
-    const SymHeap &sh1 = *heapByIdent(progState, heap1);
+    const SymHeap &sh0 = *heapByIdent(ctx.progState, heap0);
+    const SymHeap &sh1 = *heapByIdent(ctx.progState, heap1);
 
-    // compute the difference of the pair of heaps
-    TMetaOpSet metaOpsNow;
-    if (!diffHeaps(&metaOpsNow, sh0, sh1)) {
-        TM_DEBUG("diffHeaps() has failed");
+    const TMetaOpSet *pMetaOpsNow = diffOfHeapPair(ctx, heap0, heap1);
+    if (!pMetaOpsNow)
         return false;
-    }
+
+    const TMetaOpSet &metaOpsNow = *pMetaOpsNow;
 
     TObjSet freshObjs;
     BOOST_FOREACH(const MetaOperation &mo, metaOpsNow)
@@ -789,8 +897,7 @@ void seekTemplateMatchInstances(
                         objMap, fmInit.props, sh))
                 continue;
 
-            if (!processDiffOf(&fm, &metaOpsToLookFor, ctx.progState,
-                        heap0, heap1, sd))
+            if (!processDiffOf(&fm, &metaOpsToLookFor, ctx, heap0, heap1, sd))
                 // failed to process the difference of the neighbouring heaps
                 continue;
 
@@ -863,11 +970,22 @@ void matchSingleFootprint(
         const OpFootprint          &fp,
         const TFootprintIdent      &fpIdent)
 {
+    const FootprintIndex &fpi = ctx.fpIndex[fpIdent.first][fpIdent.second];
+    if (!fpi.valid)
+        // unsupported anchor heap in the template
+        return;
+
     TMetaOpSet metaOps;
     TShapeIdentSet checkedShapes;
 
-    BOOST_FOREACH(FixedPoint::TShapeSeq seq, ctx.shapeSeqs) {
+    const unsigned seqCnt = ctx.shapeSeqs.size();
+    for (unsigned seqIdx = 0U; seqIdx < seqCnt; ++seqIdx) {
+        if (ctx.maxLengthBySeq[seqIdx] < fpi.anchorLength)
+            // no shape in this sequence is long enough to map the template on
+            continue;
+
         // resolve shape sequence to search through
+        FixedPoint::TShapeSeq seq = ctx.shapeSeqs[seqIdx];
         const ESearchDirection sd = tpl.searchDirection();
         if (SD_FORWARD == sd)
             // reverse the sequence if searching _forward_
@@ -875,6 +993,11 @@ void matchSingleFootprint(
 
         // search anchor heap
         BOOST_FOREACH(const TShapeIdent &shIdent, seq) {
+            const Shape &csProg = *shapeByIdent(ctx.progState, shIdent);
+            if (csProg.length < fpi.anchorLength)
+                // each template object needs at least one program object
+                continue;
+
             TMatchList matchList;
             if (!matchAnchorHeap(&matchList, ctx, tpl, fp, fpIdent, shIdent))
                 // failed to match anchor heap
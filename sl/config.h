@@ -295,6 +295,14 @@
  */
 #define SE_STATE_PRUNING_TOTAL_THR          0x80
 
+/**
+ * if 1, each heap is run through a straight-line sequence of instructions
+ * (up to the next function call or the end of the basic block) depth-first,
+ * instead of executing the sequence instruction by instruction over the whole
+ * state; the results are the same, but the order of reported errors may differ
+ */
+#define SE_SUPERBLOCK_EXEC                  0
+
 /**
  * if 1, the symcut module allows generic minimal lengths to survive a function
  * call/return.  @b Not recommended unless SymCallCache has been rewritten to
@@ -52,6 +52,7 @@ Options::Options():
     stateLiveOrdering(SE_STATE_ON_THE_FLY_ORDERING),
     exitLeaks(SE_EXIT_LEAKS),
     detectContainers(false),
+    superblockExec(SE_SUPERBLOCK_EXEC),
     fixedPoint(0)
 {
 }
@@ -220,6 +221,12 @@ void handleTrackUninit(const string &name, const string &value)
     data.trackUninit = true;
 }
 
+void handleSuperblockExec(const string &name, const string &value)
+{
+    assumeNoValue(name, value);
+    data.superblockExec = true;
+}
+
 void handleDetectContainers(const string &name, const string &value)
 {
 #if !SH_PREVENT_AMBIGUOUS_ENT_ID
@@ -252,6 +259,7 @@ ConfigStringParser::ConfigStringParser()
     tbl_["no_plot"]                 = handleNoPlot;
     tbl_["oom"]                     = handleOOM;
     tbl_["state_live_ordering"]     = handleStateLiveOrdering;
+    tbl_["superblock_exec"]         = handleSuperblockExec;
     tbl_["track_uninit"]            = handleTrackUninit;
     tbl_["verifier_error_is_error"] = handleVerifierErrorIsError;
 }
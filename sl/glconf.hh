@@ -46,6 +46,7 @@ struct Options {
     int stateLiveOrdering;  ///< @copydoc config.h::SE_STATE_ON_THE_FLY_ORDERING
     bool exitLeaks;         ///< @copydoc config.h::SE_EXIT_LEAKS
     bool detectContainers;  ///< detect containers and operations over them
+    bool superblockExec;    ///< @copydoc config.h::SE_SUPERBLOCK_EXEC
     FixedPoint::StateByInsn *fixedPoint;  ///< fixed-point plotter (0 if unused)
 
     Options();
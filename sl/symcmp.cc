@@ -29,6 +29,7 @@
 #include "worklist.hh"
 
 #include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/tuple/tuple.hpp>
 
 bool matchOffsets(
@@ -374,3 +375,145 @@ bool areEqual(
     return sh1.matchPreds(sh2, vMap[0])
         && sh2.matchPreds(sh1, vMap[1]);
 }
+
+// /////////////////////////////////////////////////////////////////////////////
+// canonical relabeling of heaps
+typedef std::map<TObjId, unsigned>                  TCanonMap;
+
+struct CanonCtx {
+    SymHeap                    &sh;
+    size_t                      seed;
+    TCanonMap                   canonIds;
+    TObjList                    todo;
+
+    CanonCtx(SymHeap &sh_):
+        sh(sh_),
+        seed(0U)
+    {
+    }
+
+    template <typename T>
+    void mix(const T &val) {
+        boost::hash_combine(seed, val);
+    }
+
+    /// assign the next canonical ID to obj, return false if it has one already
+    bool label(const TObjId obj) {
+        const unsigned canonId = canonIds.size();
+        if (!canonIds.insert(TCanonMap::value_type(obj, canonId)).second)
+            return false;
+
+        todo.push_back(obj);
+        return true;
+    }
+};
+
+/// the properties of a pointed object that matchRoots() checks
+void canonMixObject(CanonCtx &ctx, const TObjId obj)
+{
+    const SymHeap &sh = ctx.sh;
+    const TSizeRange size = sh.objSize(obj);
+    ctx.mix(size.lo);
+    ctx.mix(size.hi);
+    ctx.mix(sh.objProtoLevel(obj));
+
+    const EObjKind kind = sh.objKind(obj);
+    ctx.mix(static_cast<int>(kind));
+    if (OK_REGION == kind)
+        return;
+
+    ctx.mix(sh.segMinLength(obj));
+    if (OK_OBJ_OR_NULL == kind)
+        return;
+
+    const BindingOff &bf = sh.segBinding(obj);
+    ctx.mix(bf.head);
+    ctx.mix(bf.next);
+    ctx.mix(bf.prev);
+}
+
+/// the properties of a pointer that cmpValues() checks
+void canonMixPointer(CanonCtx &ctx, const TValId val)
+{
+    const SymHeap &sh = ctx.sh;
+    const EValueTarget code = sh.valTarget(val);
+    ctx.mix(static_cast<int>(code));
+    ctx.mix(static_cast<int>(sh.targetSpec(val)));
+
+    if (VT_RANGE == code) {
+        const IR::Range rng = sh.valOffsetRange(val);
+        ctx.mix(rng.lo);
+        ctx.mix(rng.hi);
+    }
+    else
+        ctx.mix(sh.valOffset(val));
+
+    const TObjId obj = sh.objByAddr(val);
+    ctx.mix(sh.isValid(obj));
+    if (ctx.label(obj))
+        canonMixObject(ctx, obj);
+
+    ctx.mix(ctx.canonIds[obj]);
+}
+
+void canonFollowFields(CanonCtx &ctx, const TObjId obj)
+{
+    const SymHeap &sh = ctx.sh;
+    FldList fields;
+    sh.gatherLiveFields(fields, obj);
+
+    // only pointers are hashed, other values may be implicit in an isomorphic
+    // heap (e.g. a NULL field covered by a nullified block)
+    typedef std::map<TOffset, TValId> TPtrByOff;
+    TPtrByOff ptrByOff;
+    std::set<TOffset> ambiguous;
+    BOOST_FOREACH(const FldHandle &fld, fields) {
+        const TValId val = fld.value();
+        if (val <= VAL_NULL || !isAnyDataArea(sh.valTarget(val)))
+            continue;
+
+        const TOffset off = fld.offset();
+        const TPtrByOff::value_type item(off, val);
+        const std::pair<TPtrByOff::iterator, bool> ret = ptrByOff.insert(item);
+        if (!ret.second && val != ret.first->second)
+            // distinct pointers at the same offset, their order is arbitrary
+            ambiguous.insert(off);
+    }
+
+    BOOST_FOREACH(TPtrByOff::const_reference item, ptrByOff) {
+        const TOffset off = item.first;
+        if (hasKey(ambiguous, off))
+            continue;
+
+        ctx.mix(off);
+        canonMixPointer(ctx, /* val */ item.second);
+    }
+}
+
+size_t canonicalHash(const SymHeap &sh)
+{
+    SymHeap &shWritable = const_cast<SymHeap &>(sh);
+    CanonCtx ctx(shWritable);
+
+    // program variables come first, ordered by uid
+    TCVarSet vars;
+    gatherProgramVars(vars, sh);
+    BOOST_FOREACH(const CVar &cv, vars) {
+        ctx.mix(cv.uid);
+        ctx.mix(cv.inst);
+
+        const TObjId reg =
+            shWritable.regionByVar(cv, /* createIfNeeded */ false);
+        ctx.label(reg);
+    }
+
+    // DFS through pointer fields
+    while (!ctx.todo.empty()) {
+        const TObjId obj = ctx.todo.back();
+        ctx.todo.pop_back();
+        ctx.mix(ctx.canonIds[obj]);
+        canonFollowFields(ctx, obj);
+    }
+
+    return ctx.seed;
+}
@@ -37,6 +37,18 @@ bool areEqual(
         const SymHeap           &sh1,
         const SymHeap           &sh2);
 
+/**
+ * hash of the heap that does not depend on the IDs of its objects and values
+ *
+ * Objects reachable from program variables are relabeled in the order of a
+ * deterministic DFS that starts at the variables (ordered by uid) and follows
+ * pointer fields in the order of their offsets.  Only the properties checked
+ * by areEqual() are hashed, so heaps equal up to isomorphism always have the
+ * same hash.  The hash does not depend on addresses, so it is stable across
+ * runs.
+ */
+size_t canonicalHash(const SymHeap &sh);
+
 inline bool checkNonPosValues(int a, int b)
 {
     if (0 < a && 0 < b)
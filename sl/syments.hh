@@ -169,6 +169,97 @@ struct EntCounter {
 #endif
 };
 
+/**
+ * table of entity pointers, shared among copies of EntStore until written
+ *
+ * The IDs come from a counter shared by all heaps (see EntCounter), so the
+ * IDs used by a single heap are scattered over a range that grows with each
+ * heap created.  The table is thus split into pages of PAGE_SIZE pointers and
+ * only the pages holding an entity of the heap are allocated, copied and
+ * walked through.
+ */
+template <class TBaseEnt>
+struct EntTable {
+    enum {
+        PAGE_BITS = 6,
+        PAGE_SIZE = 1 << PAGE_BITS
+    };
+
+    struct Page {
+        TBaseEnt               *ents[PAGE_SIZE];
+    };
+
+    std::vector<Page *>         pages;
+    long                        size;       ///< last ID in the table plus one
+    RefCounter                  refCnt;
+
+    EntTable():
+        size(0L)
+    {
+    }
+
+    EntTable(const EntTable &ref):
+        pages(ref.pages.size(), 0),
+        size(ref.size)
+    {
+        const unsigned cnt = pages.size();
+        for (unsigned i = 0; i < cnt; ++i) {
+            const Page *src = ref.pages[i];
+            if (!src)
+                continue;
+
+            Page *dst = new Page(*src);
+            pages[i] = dst;
+            BOOST_FOREACH(TBaseEnt *&ent, dst->ents)
+                if (ent)
+                    RefCntLib<RCO_VIRTUAL>::enter(ent);
+        }
+    }
+
+    ~EntTable() {
+        BOOST_FOREACH(Page *page, pages) {
+            if (!page)
+                continue;
+
+            BOOST_FOREACH(TBaseEnt *ent, page->ents)
+                if (ent)
+                    RefCntLib<RCO_VIRTUAL>::leave(ent);
+
+            delete page;
+        }
+    }
+
+    /// return the entity of the given ID, or 0 if there is none
+    TBaseEnt* at(const long id) const {
+        const Page *page = pages[id >> PAGE_BITS];
+        return (page)
+            ? page->ents[id & (PAGE_SIZE - 1)]
+            : 0;
+    }
+
+    /// return a reference to the slot of the given ID, allocate it if needed
+    TBaseEnt*& slot(const long id) {
+        Page *&page = pages[id >> PAGE_BITS];
+        if (!page)
+            page = new Page();
+
+        return page->ents[id & (PAGE_SIZE - 1)];
+    }
+
+    /// enlarge the table such that it covers the given ID
+    void cover(const long id) {
+        if (id < size)
+            return;
+
+        size = id + 1L;
+        pages.resize(1U + (id >> PAGE_BITS), 0);
+    }
+
+    private:
+        // intentionally not implemented
+        EntTable& operator=(const EntTable &);
+};
+
 template <class TBaseEnt>
 class EntStore {
     public:
@@ -183,7 +274,7 @@ class EntStore {
 
         template <typename TId> TId lastId() const {
             // we need to be careful with integral arithmetic on enums
-            const long last = -1L + ents_.size();
+            const long last = -1L + tbl_->size;
             return static_cast<TId>(last);
         }
 
@@ -204,7 +295,7 @@ class EntStore {
         // intentionally not implemented
         EntStore& operator=(const EntStore &);
 
-        std::vector<TBaseEnt *>                 ents_;
+        EntTable<TBaseEnt>                     *tbl_;
         EntCounter                             *entCnt_;
 };
 
@@ -221,8 +312,9 @@ TId EntStore<TBaseEnt>::assignId(TBaseEnt *ptr)
     this->assignId(id, ptr);
     return id;
 #else
-    this->ents_.push_back(ptr);
-    return this->lastId<TId>();
+    const TId id = static_cast<TId>(tbl_->size);
+    this->assignId(id, ptr);
+    return id;
 #endif
 }
 
@@ -232,11 +324,12 @@ void EntStore<TBaseEnt>::assignId(const TId id, TBaseEnt *ptr)
 {
     CL_BREAK_IF(ptr->refCnt.isShared());
 
+    RefCntLib<RCO_NON_VIRT>::requireExclusivity(tbl_);
+
     // make sure we have enough space allocated
-    if (this->lastId<TId>() < id)
-        ents_.resize(id + 1, 0);
+    tbl_->cover(id);
 
-    TBaseEnt *&ref = ents_[id];
+    TBaseEnt *&ref = tbl_->slot(id);
 
     // if this fails, you wanted to overwrite pointer to a valid entity
     CL_BREAK_IF(ref);
@@ -253,7 +346,8 @@ template <class TBaseEnt>
 template <typename TId>
 void EntStore<TBaseEnt>::releaseEnt(const TId id)
 {
-    RefCntLib<RCO_VIRTUAL>::leave(ents_[id]);
+    RefCntLib<RCO_NON_VIRT>::requireExclusivity(tbl_);
+    RefCntLib<RCO_VIRTUAL>::leave(tbl_->slot(id));
 }
 
 template <class TBaseEnt>
@@ -263,20 +357,21 @@ bool EntStore<TBaseEnt>::isValidEnt(const TId id) const
     if (this->outOfRange(id))
         return false;
 
-    return !!ents_[id];
+    return !!tbl_->at(id);
 }
 
 template <class TBaseEnt>
-EntStore<TBaseEnt>::EntStore()
+EntStore<TBaseEnt>::EntStore():
+    tbl_(new EntTable<TBaseEnt>)
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
-    : entCnt_(new EntCounter)
+    , entCnt_(new EntCounter)
 #endif
 {
 }
 
 template <class TBaseEnt>
 EntStore<TBaseEnt>::EntStore(const EntStore &ref):
-    ents_(ref.ents_)
+    tbl_(ref.tbl_)
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     , entCnt_(ref.entCnt_)
 #endif
@@ -284,9 +379,8 @@ EntStore<TBaseEnt>::EntStore(const EntStore &ref):
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     RefCntLib<RCO_NON_VIRT>::enter(entCnt_);
 #endif
-    BOOST_FOREACH(TBaseEnt *&ent, ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::enter(ent);
+    // the table is cloned as soon as one of the copies is written
+    RefCntLib<RCO_NON_VIRT>::enter(tbl_);
 }
 
 template <class TBaseEnt>
@@ -295,9 +389,7 @@ EntStore<TBaseEnt>::~EntStore()
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     RefCntLib<RCO_NON_VIRT>::leave(entCnt_);
 #endif
-    BOOST_FOREACH(TBaseEnt *ent, ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::leave(ent);
+    RefCntLib<RCO_NON_VIRT>::leave(tbl_);
 }
 
 template <class TBaseEnt>
@@ -308,7 +400,7 @@ inline const TBaseEnt* EntStore<TBaseEnt>::getEntRO(const TId id)
     CL_BREAK_IF(this->outOfRange(id));
 
     // if this fails, the ID is no longer valid
-    const TBaseEnt *ptr = ents_[id];
+    const TBaseEnt *ptr = tbl_->at(id);
     CL_BREAK_IF(!ptr);
     return ptr;
 }
@@ -320,7 +412,8 @@ inline TBaseEnt* EntStore<TBaseEnt>::getEntRW(const TId id)
 #ifndef NDEBUG
     this->getEntRO(id);
 #endif
-    TBaseEnt *&entRW = ents_[id];
+    RefCntLib<RCO_NON_VIRT>::requireExclusivity(tbl_);
+    TBaseEnt *&entRW = tbl_->slot(id);
     RefCntLib<RCO_VIRTUAL>::requireExclusivity(entRW);
     return entRW;
 }
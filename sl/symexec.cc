@@ -42,6 +42,7 @@
 #include <set>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include <boost/foreach.hpp>
 
@@ -182,13 +183,15 @@ class SymExecEngine: public IStatsProvider {
 
         bool handleExitPoint(const SymHeap &);
 
-        void execJump();
-        void execAbort();
-        void execReturn();
-        void execCondInsn();
-        void execTermInsn();
-        bool execNontermInsn();
+        void execJump(SymHeap &sh);
+        void execAbort(SymHeap &sh);
+        void execReturn(SymHeap &sh);
+        void execCondInsn(SymHeap &sh);
+        void execTermInsn(SymHeap &sh);
+        bool execNontermInsn(SymState &dst, SymHeap *sh);
         bool execInsn();
+        unsigned straightLineEnd() const;
+        void execStraightLine(const unsigned end);
         bool execBlock();
         void processPendingSignals();
         void pruneOrigin();
@@ -227,30 +230,20 @@ void SymExecEngine::initEngine(const SymHeap &init)
     sched_.schedule(entry);
 }
 
-void SymExecEngine::execJump()
+void SymExecEngine::execJump(SymHeap &sh)
 {
     const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
     const CodeStorage::TTargetList &tlist = insn->targets;
-
-    // make a copy in case we needed to perform an abstraction
-    const SymHeap &origin = localState_[heapIdx_];
-    SymHeap sh(origin);
-    Trace::waiveCloneOperation(sh);
-
     this->updateState(sh, tlist[/* target */ 0]);
 }
 
-void SymExecEngine::execReturn()
+void SymExecEngine::execReturn(SymHeap &sh)
 {
     const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
     const CodeStorage::TOperandList &opList = insn->operands;
     CL_BREAK_IF(1 != opList.size());
 
-    // create a local copy of the heap
-    const SymHeap &origin = localState_[heapIdx_];
-    SymHeap sh(origin);
-
-    Trace::Node *trOrig = origin.traceNode();
+    Trace::Node *trOrig = sh.traceNode();
     Trace::Node *trRet = new Trace::InsnNode(trOrig, insn, /* bin */ false);
     sh.traceUpdate(trRet);
 
@@ -448,7 +441,7 @@ skip_tracking:
     return true;
 }
 
-void SymExecEngine::execCondInsn()
+void SymExecEngine::execCondInsn(SymHeap &sh)
 {
     // we should get a CL_INSN_BINOP instruction and a CL_INSN_COND instruction
     const CodeStorage::Insn *insnCmp = block_->operator[](insnIdx_ - 1);
@@ -469,10 +462,6 @@ void SymExecEngine::execCondInsn()
     const struct cl_operand &op2 = insnCmp->operands[/* src2 */ 2];
     CL_BREAK_IF(!areComparableTypes(op1.type, op2.type));
 
-    // a working area in case of VAL_TRUE and VAL_FALSE
-    SymHeap sh(localState_[heapIdx_]);
-    Trace::waiveCloneOperation(sh);
-
     // initialize execution properties based on the global configuration
     const SymExecCoreParams ep(GlConf::data);
 
@@ -547,7 +536,7 @@ void SymExecEngine::execCondInsn()
     this->updateStateInBranch(sh, false, *insnCmp, *insnCnd, v1, v2);
 }
 
-void SymExecEngine::execAbort()
+void SymExecEngine::execAbort(SymHeap &sh)
 {
     CL_DEBUG_MSG(lw_, "CL_INSN_ABORT reached");
     endReached_ = true;
@@ -557,32 +546,30 @@ void SymExecEngine::execAbort()
         return;
 
     // propagate the exit point back to the caller to catch leaks in context
-    SymHeap sh = localState_[heapIdx_];
-    Trace::waiveCloneOperation(sh);
     sh.setExitPoint(&bt_);
     this->handleExitPoint(sh);
 }
 
-void SymExecEngine::execTermInsn()
+void SymExecEngine::execTermInsn(SymHeap &sh)
 {
     const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
 
     const enum cl_insn_e code = insn->code;
     switch (code) {
         case CL_INSN_RET:
-            this->execReturn();
+            this->execReturn(sh);
             break;
 
         case CL_INSN_JMP:
-            this->execJump();
+            this->execJump(sh);
             break;
 
         case CL_INSN_COND:
-            this->execCondInsn();
+            this->execCondInsn(sh);
             break;
 
         case CL_INSN_ABORT:
-            this->execAbort();
+            this->execAbort(sh);
             break;
 
         default:
@@ -590,24 +577,19 @@ void SymExecEngine::execTermInsn()
     }
 }
 
-bool /* handled */ SymExecEngine::execNontermInsn()
+/// @param sh the heap to execute the instruction in, ownership is transferred
+bool /* handled */ SymExecEngine::execNontermInsn(SymState &dst, SymHeap *sh)
 {
     const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
 
     // initialize execution properties based on the global configuration
     const SymExecCoreParams ep(GlConf::data);
 
-    // working area for non-terminal instructions
-    const SymHeap &origin = localState_[heapIdx_];
-    SymHeap sh(origin);
     SymExecCore core(sh, &bt_, ep);
     core.setLocation(lw_);
 
-    // drop the unnecessary Trace::CloneNode node in the trace graph
-    Trace::waiveCloneOperation(sh);
-
     // execute the instruction
-    if (!core.exec(nextLocalState_, *insn)) {
+    if (!core.exec(dst, *insn)) {
         CL_BREAK_IF(CL_INSN_CALL != insn->code);
         return false;
     }
@@ -706,12 +688,30 @@ bool /* complete */ SymExecEngine::execInsn()
             continue;
 
         if (isTerm) {
-            // terminal insn
-            this->execTermInsn();
+            // terminal insn, the heap is not needed in localState_ any more,
+            // so we can take it instead of making a copy
+            SymHeap *sh = localState_.release(heapIdx_);
+            this->execTermInsn(*sh);
+            delete sh;
             continue;
         }
 
-        if (this->execNontermInsn())
+        // working area for non-terminal instructions
+        SymHeap *sh;
+        if (CL_INSN_CALL == insn->code) {
+            // the heap is kept in localState_ as the entry of a possible call,
+            // see callEntry()
+            sh = new SymHeap(localState_[heapIdx_]);
+
+            // drop the unnecessary Trace::CloneNode node in the trace graph
+            Trace::waiveCloneOperation(*sh);
+        }
+        else
+            // localState_ is discarded after the instruction, so we can execute
+            // the instruction in place and move the heap to nextLocalState_
+            sh = localState_.release(heapIdx_);
+
+        if (this->execNontermInsn(nextLocalState_, sh))
             // regular heap instruction
             continue;
 
@@ -728,6 +728,129 @@ bool /* complete */ SymExecEngine::execInsn()
     return true;
 }
 
+/// return index past the straight-line sequence of insns starting at insnIdx_
+unsigned SymExecEngine::straightLineEnd() const
+{
+    const unsigned size = block_->size();
+    for (unsigned i = insnIdx_; i < size; ++i) {
+        const enum cl_insn_e code = block_->operator[](i)->code;
+        if (CL_INSN_CALL == code)
+            // a call needs to suspend the engine, see callEntry()
+            return i;
+
+        if (cl_is_term_insn(code))
+            return i + 1;
+    }
+
+    CL_BREAK_IF("SymExecEngine::straightLineEnd() missed terminal insn");
+    return size;
+}
+
+/**
+ * execute the insns from insnIdx_ up to (but excluding) @b end, running each
+ * heap of localState_ through the whole sequence before taking the next one,
+ * such that only a heap being split by an insn gives rise to more heaps alive
+ * at a time.  The resulting heaps are left in localState_ in the same order
+ * as execInsn() would have produced them and insnIdx_ points to the last insn
+ * of the sequence.
+ */
+void SymExecEngine::execStraightLine(const unsigned end)
+{
+    typedef std::pair<SymHeap *, unsigned /* insn */> TItem;
+
+    const unsigned first = insnIdx_;
+    CL_DEBUG_MSG(lw_, "!!! executing insns #" << first << " .. #" << (end - 1)
+            << " depth-first, " << localState_.size() << " heap(s)");
+
+    // resolve locations of the insns the same way execBlock() does
+    std::vector<const struct cl_loc *> locs(end, lw_);
+    for (unsigned i = first; i < end; ++i) {
+        const CodeStorage::Insn *insn = block_->operator[](i);
+        if (0 < insn->loc.line)
+            lw_ = &insn->loc;
+
+        locs[i] = lw_;
+    }
+
+    // used only if (0 == first)
+    SymStateMarked &origin = stateMap_[block_];
+
+    // the stack keeps the heap to be executed next at the back
+    std::vector<TItem> todo;
+    const unsigned hCnt = localState_.size();
+    for (int i = hCnt - 1; 0 <= i; --i) {
+        if (!first) {
+            if (origin.isDone(i))
+                // the result is already included in the resulting state
+                continue;
+
+            // mark as processed now since it can be re-scheduled right away
+            origin.setDone(i);
+        }
+
+        todo.push_back(TItem(localState_.release(i), first));
+    }
+
+    if (!first)
+        this->pruneOrigin();
+
+    SymHeapList results;
+    while (!todo.empty()) {
+        SymHeap *sh = todo.back().first;
+        insnIdx_ = todo.back().second;
+        todo.pop_back();
+
+        if (end == insnIdx_) {
+            // the heap has made it through the whole sequence
+            results.adopt(sh);
+            continue;
+        }
+
+        const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
+        lw_ = locs[insnIdx_];
+
+        // capture fixed-point for plotting if configured to do so
+        if (GlConf::data.fixedPoint)
+            GlConf::data.fixedPoint->insert(insn, *sh);
+
+        if (insnIdx_ + 1 < end
+                && CL_INSN_COND == block_->operator[](insnIdx_ + 1)->code)
+        {
+            // this is going to be handled in execCondInsn() right away
+            CL_BREAK_IF(CL_INSN_BINOP != insn->code);
+            todo.push_back(TItem(sh, insnIdx_ + 1));
+            continue;
+        }
+
+        // time to respond to a single pending signal
+        this->processPendingSignals();
+
+        if (this->handleExitPoint(*sh)) {
+            // program exited on this execution path, go directly to the caller
+            delete sh;
+            continue;
+        }
+
+        if (cl_is_term_insn(insn->code)) {
+            this->execTermInsn(*sh);
+            delete sh;
+            continue;
+        }
+
+        SymHeapList next;
+        if (!this->execNontermInsn(next, sh)) {
+            CL_BREAK_IF("SymExecEngine::execStraightLine() got a call");
+        }
+
+        for (int i = next.size() - 1; 0 <= i; --i)
+            todo.push_back(TItem(next.release(i), insnIdx_ + 1));
+    }
+
+    localState_.swap(results);
+    insnIdx_ = end - 1;
+    lw_ = locs[insnIdx_];
+}
+
 bool /* complete */ SymExecEngine::execBlock()
 {
     const std::string &name = block_->name();
@@ -752,6 +875,17 @@ bool /* complete */ SymExecEngine::execBlock()
 
     // go through the remainder of BB insns
     for (; insnIdx_ < block_->size(); ++insnIdx_) {
+        if (GlConf::data.superblockExec && !heapIdx_) {
+            const unsigned end = this->straightLineEnd();
+            if (insnIdx_ + 1 < end) {
+                // there is nothing to suspend on, run heaps one by one
+                this->execStraightLine(end);
+                if (!localState_.size())
+                    break;
+
+                continue;
+            }
+        }
 
         const CodeStorage::Insn *insn = block_->operator[](insnIdx_);
         if (0 < insn->loc.line)
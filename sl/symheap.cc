@@ -650,7 +650,14 @@ struct SymHeapCore::Private {
     bool /* wasPtr */ releaseValueOf(TFldId fld, TValId val);
     void registerValueOf(TFldId fld, TValId val);
     void splitBlockByObject(TFldId block, TFldId fld);
-    bool writeCharToString(TValId *pValDst, const TValId, const TOffset);
+    bool writeCharToString(
+            TValId                 *pValDst,
+            const TValId            valToWrite,
+            const TOffset           pos,
+            const TSizeOf           limit);
+
+    bool writeCharIntoString(TFldId fld, TValId val, TValSet *killedPtrs);
+    bool startStringInNullBlock(TFldId fld, TValId val, TValSet *killedPtrs);
     bool reinterpretSingleObj(FieldOfObj *dstData, const BlockEntity *srcData);
     void reinterpretObjData(TFldId old, TFldId fld, TValSet *killedPtrs = 0);
     void setValueOf(TFldId of, TValId val, TValSet *killedPtrs = 0);
@@ -681,6 +688,16 @@ struct SymHeapCore::Private {
             const UniformBlock     &ub,
             TValSet                *killedPtrs);
 
+    void mergeUniformBlock(TFldId block);
+
+    bool findStringEnd(TOffset *pDst, const BlockEntity *blData);
+
+    bool isCoveredByNullBlock(const FieldOfObj *fldData);
+
+    TFldId liveBlockAt(const Region *regData, TOffset off, TFldId except);
+
+    bool isNullByteAt(const Region *regData, TOffset off, TFldId except);
+
     bool findZeroInBlock(
             TOffset                *offDst,
             bool                   *provenPrefix,
@@ -698,6 +715,10 @@ struct SymHeapCore::Private {
 
     TValId wrapIntVal(const IR::TInt);
 
+    bool charOfVal(IR::TInt *pDst, TValId val);
+
+    TValId wrapStringVal(const std::string &);
+
     void replaceRngByInt(const InternalCustomValue *valData);
 
     void trimCustomValue(TValId val, const IR::Range &win);
@@ -1021,8 +1042,14 @@ bool isCoveredByBlock(
 
 inline bool isChar(const TObjType clt)
 {
-    return (CL_TYPE_INT == clt->code)
-        && (1 == clt->size);
+    switch (clt->code) {
+        case CL_TYPE_CHAR:
+        case CL_TYPE_INT:
+            return (1 == clt->size);
+
+        default:
+            return false;
+    }
 }
 
 inline bool isString(const TObjType clt)
@@ -1031,6 +1058,43 @@ inline bool isString(const TObjType clt)
         && isChar(targetTypeOfArray(clt));
 }
 
+/// return an array of chars of the given size that the front-end may not know
+TObjType stringTypeOf(const TObjType cltChar, const TSizeOf size)
+{
+    CL_BREAK_IF(!isChar(cltChar) || size <= 0);
+
+    // the synthesized types are shared by all heaps and never released
+    typedef std::pair<TObjType, TSizeOf>                TKey;
+    typedef std::map<TKey, TObjType>                    TCache;
+    static TCache cache;
+    static int lastUid;
+
+    TObjType &clt = cache[TKey(cltChar, size)];
+    if (clt)
+        return clt;
+
+    struct cl_type_item *item = new struct cl_type_item;
+    item->type      = cltChar;
+    item->name      = 0;
+    item->offset    = 0;
+
+    struct cl_type *cltArr = new struct cl_type;
+    *cltArr = *cltChar;
+
+    // negative UIDs do not collide with the types of the front-end
+    cltArr->uid         = --lastUid;
+    cltArr->code        = CL_TYPE_ARRAY;
+    cltArr->name        = 0;
+    cltArr->size        = size;
+    cltArr->item_cnt    = 1;
+    cltArr->items       = item;
+    cltArr->array_size  = size;
+    cltArr->is_unsigned = false;
+
+    clt = cltArr;
+    return clt;
+}
+
 /// return true if pointer value can be preserved during data reinterpretation
 bool canReinterpretPtr(const TObjType cltDst, const TObjType cltSrc)
 {
@@ -1055,7 +1119,8 @@ bool canReinterpretPtr(const TObjType cltDst, const TObjType cltSrc)
 bool SymHeapCore::Private::writeCharToString(
         TValId                     *pValDst,
         const TValId                valToWrite,
-        const TOffset               pos)
+        const TOffset               pos,
+        const TSizeOf               limit)
 {
     const TValId valDst = *pValDst;
     if (VAL_INVALID == valDst)
@@ -1071,44 +1136,42 @@ bool SymHeapCore::Private::writeCharToString(
     // extract the string that is going to be modified
     const InternalCustomValue *stringData =
         DCAST<const InternalCustomValue *>(dstData);
-    std::string str(stringData->customData.str());
-    CL_BREAK_IF(static_cast<TOffset>(str.size()) < pos || pos < 0);
+    const CustomValue &cvDst = stringData->customData;
+    if (CV_STRING != cvDst.code())
+        // there is no string to write to
+        return false;
 
-    // modify the string accordingly as long as the result is still a string
-    if (VAL_NULL == valToWrite)
-        str.resize(pos);
-    else {
-        const BaseValue *valData;
-        this->ents.getEntRO(&valData, valToWrite);
-        if (VT_CUSTOM != valData->code)
-            return false;
+    std::string str(cvDst.str());
+    CL_BREAK_IF(limit <= pos || pos < 0);
 
-        const InternalCustomValue *numData =
-            DCAST<const InternalCustomValue *>(valData);
+    const TOffset len = str.size();
+    if (len < pos || (len == pos && VAL_NULL == valToWrite))
+        // the string is followed by zeros up to the end of the array
+        return (VAL_NULL == valToWrite);
 
-        const IR::Range rng = numData->customData.rng();
-        if (!isSingular(rng))
-            return false;
+    if (len == pos && limit <= pos + /* trailing zero */ 1)
+        // the string would not be zero-terminated any more
+        return false;
 
-        const IR::TInt num = rng.lo;
+    if (VAL_NULL == valToWrite)
+        // the chars behind pos are still there and need not be followed by
+        // zeros, so the array cannot be described by a shorter string
+        return false;
+
+    // only a known non-zero char keeps the string a string
+    IR::TInt num;
+    if (!this->charOfVal(&num, valToWrite))
+        return false;
+
+    if (len == pos)
+        // append a char, the trailing zero is implied by the array
+        str.push_back(num);
+    else
         str[pos] = num;
-    }
 
     // update the mapping of the string being assigned
     CL_DEBUG("CV_STRING replaced as a consequence of data reinterpretation");
-    RefCntLib<RCO_NON_VIRT>::requireExclusivity(this->cValueMap);
-    const CustomValue cvStr(str.c_str());
-    TValId &valStr = this->cValueMap->lookup(cvStr);
-
-    if (VAL_INVALID == valStr) {
-        // CV_STRING not found, wrap it as a new heap value
-        valStr = this->valCreate(VT_CUSTOM, VO_ASSIGNED);
-        InternalCustomValue *dstData;
-        this->ents.getEntRW(&dstData, valStr);
-        dstData->customData = cvStr;
-    }
-
-    *pValDst = valStr;
+    *pValDst = this->wrapStringVal(str);
     return true;
 }
 
@@ -1159,7 +1222,8 @@ bool SymHeapCore::Private::reinterpretSingleObj(
     if (isChar(cltSrc) && isString(cltDst)) {
         // write char to a zero-terminated string
         const TOffset off = srcData->off - dstData->off;
-        return this->writeCharToString(&dstData->value, valSrc, off);
+        return this->writeCharToString(&dstData->value, valSrc, off,
+                cltDst->size);
     }
 
     if ((VT_OBJECT == valData->code)
@@ -1508,8 +1572,12 @@ void SymHeapCore::Private::transferBlock(
             continue;
 
         // copy a single live block
-        this->copySingleLiveBlock(objDst, objDataDst, objSrc, code,
-                realShift, sizeLimit);
+        const TFldId dst = this->copySingleLiveBlock(objDst, objDataDst,
+                objSrc, code, realShift, sizeLimit);
+
+        if (BK_UNIFORM == code)
+            // do not fragment the target by copying the blocks one by one
+            this->mergeUniformBlock(dst);
     }
 }
 
@@ -1570,6 +1638,12 @@ TValId SymHeapCore::Private::fldInit(TFldId fld)
     const TOffset off = fldData->off;
     const TObjType clt = fldData->clt;
 
+    if (!isComposite(clt) && this->isCoveredByNullBlock(fldData)) {
+        // the field may span several nullified blocks or the zeros of a string
+        fldData->value = VAL_NULL;
+        return VAL_NULL;
+    }
+
     // first check for data reinterpretation
     TFldIdSet overlaps;
     if (arenaLookup(&overlaps, arena, createChunk(off, clt), fld)) {
@@ -2009,9 +2083,24 @@ void SymHeapCore::setValOfField(TFldId fld, TValId val, TValSet *killedPtrs)
     const TObjType clt = fldData->clt;
     CL_BREAK_IF(VT_COMPOSITE == this->valTarget(val));
 
-    // mark the destination object as live
     Region *regData;
     d->ents.getEntRW(&regData, fldData->obj);
+    if (VAL_NULL == val && CL_TYPE_PTR != clt->code
+            && !hasKey(regData->liveFields, fld)
+            && (VAL_INVALID == fldData->value || VAL_NULL == fldData->value)
+            && d->isCoveredByNullBlock(fldData))
+        // writing zero to memory that is already nullified, the field will be
+        // initialized from the uniform block once it is read, see fldInit();
+        // a dead field that still holds a non-zero value needs to be written
+        // though, valueOf() would return the stale value otherwise
+        return;
+
+    if (isChar(clt) && (d->writeCharIntoString(fld, val, killedPtrs)
+                || d->startStringInNullBlock(fld, val, killedPtrs)))
+        // the string is updated in place, the char is read from it on demand
+        return;
+
+    // mark the destination object as live
     regData->liveFields[fld] = bkFromClt(clt);
 
     // now set the value
@@ -2057,13 +2146,276 @@ TFldId SymHeapCore::Private::writeUniformBlock(
     return fld;
 }
 
-/// just a trivial wrapper to hide the return value
+/// true if the block is a string, *pDst is then the offset of its trailing zero
+bool SymHeapCore::Private::findStringEnd(
+        TOffset                    *pDst,
+        const BlockEntity          *blData)
+{
+    if (BK_FIELD != blData->code)
+        return false;
+
+    const FieldOfObj *fldData = DCAST<const FieldOfObj *>(blData);
+    if (!isString(fldData->clt) || VAL_INVALID == fldData->value)
+        return false;
+
+    const BaseValue *valData;
+    this->ents.getEntRO(&valData, fldData->value);
+    if (VT_CUSTOM != valData->code)
+        return false;
+
+    const CustomValue &cv =
+        DCAST<const InternalCustomValue *>(valData)->customData;
+    if (CV_STRING != cv.code())
+        return false;
+
+    *pDst = fldData->off + cv.str().size();
+    return true;
+}
+
+/// true if the field lies in nullified memory and no non-zero data overlap it
+bool SymHeapCore::Private::isCoveredByNullBlock(const FieldOfObj *fldData)
+{
+    const Region *regData;
+    this->ents.getEntRO(&regData, fldData->obj);
+
+    TFldIdSet overlaps;
+    const TMemChunk chunk = createChunk(fldData->off, fldData->clt);
+    if (!arenaLookup(&overlaps, regData->arena, chunk, FLD_INVALID))
+        return false;
+
+    // live blocks do not overlap each other, so we can sum up the zero bytes
+    const TOffset beg = fldData->off;
+    const TOffset end = beg + fldData->clt->size;
+    TSizeOf covered = 0;
+
+    BOOST_FOREACH(const TFldId other, overlaps) {
+        if (!hasKey(regData->liveFields, other))
+            continue;
+
+        const BlockEntity *blData;
+        this->ents.getEntRO(&blData, other);
+        if (BK_COMPOSITE == blData->code)
+            // only a place-holder for the fields the object consists of
+            continue;
+
+        TOffset zeroBeg = blData->off;
+        if (VAL_NULL == blData->value) {
+            if (BK_UNIFORM != blData->code)
+                // a zero stored in a field of another type does not count
+                continue;
+        }
+        else if (!this->findStringEnd(&zeroBeg, blData) || beg < zeroBeg)
+            // non-zero data overlap the field
+            return false;
+
+        const TOffset zeroEnd = blData->off + blData->size;
+        covered += std::min(end, zeroEnd) - std::max(beg, zeroBeg);
+    }
+
+    return (end - beg == covered);
+}
+
+/// return the live block (other than except) that covers the byte at off
+TFldId SymHeapCore::Private::liveBlockAt(
+        const Region               *regData,
+        const TOffset               off,
+        const TFldId                except)
+{
+    TFldIdSet overlaps;
+    const TMemChunk chunk(off, off + /* a single byte */ 1);
+    if (!arenaLookup(&overlaps, regData->arena, chunk, except))
+        return FLD_INVALID;
+
+    BOOST_FOREACH(const TFldId fld, overlaps) {
+        const TLiveObjs::const_iterator it = regData->liveFields.find(fld);
+        if (regData->liveFields.end() == it || BK_COMPOSITE == it->second)
+            // dead or only a place-holder for the fields of a composite object
+            continue;
+
+        // live blocks do not overlap each other, so there is at most one
+        return fld;
+    }
+
+    return FLD_INVALID;
+}
+
+/// true if the byte at off lies in a live nullified uniform block
+bool SymHeapCore::Private::isNullByteAt(
+        const Region               *regData,
+        const TOffset               off,
+        const TFldId                except)
+{
+    const TFldId block = this->liveBlockAt(regData, off, except);
+    if (FLD_INVALID == block)
+        return false;
+
+    const BlockEntity *blData;
+    this->ents.getEntRO(&blData, block);
+    return (BK_UNIFORM == blData->code)
+        && (VAL_NULL == blData->value);
+}
+
+/// write a char into a live zero-terminated string without splitting it
+bool SymHeapCore::Private::writeCharIntoString(
+        const TFldId                fld,
+        const TValId                val,
+        TValSet                    *killedPtrs)
+{
+    const FieldOfObj *fldData;
+    this->ents.getEntRO(&fldData, fld);
+
+    const Region *regData;
+    this->ents.getEntRO(&regData, fldData->obj);
+    if (hasKey(regData->liveFields, fld))
+        // the char is already stored separately
+        return false;
+
+    const TFldId str = this->liveBlockAt(regData, fldData->off, fld);
+    if (FLD_INVALID == str)
+        return false;
+
+    const BlockEntity *blData;
+    this->ents.getEntRO(&blData, str);
+    if (BK_FIELD != blData->code)
+        return false;
+
+    const FieldOfObj *strData = DCAST<const FieldOfObj *>(blData);
+    const TObjType cltStr = strData->clt;
+    if (!isString(cltStr))
+        return false;
+
+    TValId valStr = strData->value;
+    const TOffset beg = strData->off;
+    const TOffset pos = fldData->off - beg;
+    TSizeOf limit = cltStr->size;
+    if (VAL_NULL != val && limit == pos + /* trailing zero */ 1
+            && this->isNullByteAt(regData, beg + limit, str))
+        // the array behind the string is nullified, let the string grow
+        ++limit;
+
+    if (!this->writeCharToString(&valStr, val, pos, limit))
+        return false;
+
+    TFldId dst = str;
+    if (cltStr->size < limit) {
+        // replace the string by a longer one at the same offset
+        const TObjType cltChar = targetTypeOfArray(cltStr);
+        dst = this->fldCreate(fldData->obj, beg, stringTypeOf(cltChar, limit));
+
+        Region *regDataRW;
+        this->ents.getEntRW(&regDataRW, fldData->obj);
+        regDataRW->liveFields[dst] = BK_FIELD;
+    }
+
+    // the dead fields overlapping the string are reinterpreted by setValueOf()
+    this->setValueOf(dst, valStr, killedPtrs);
+    return true;
+}
+
+/// write a non-zero char to nullified memory as a string of a single char
+bool SymHeapCore::Private::startStringInNullBlock(
+        const TFldId                fld,
+        const TValId                val,
+        TValSet                    *killedPtrs)
+{
+    const FieldOfObj *fldData;
+    this->ents.getEntRO(&fldData, fld);
+
+    const TObjId obj = fldData->obj;
+    const TOffset off = fldData->off;
+
+    Region *regData;
+    this->ents.getEntRW(&regData, obj);
+    if (hasKey(regData->liveFields, fld))
+        // the char is already stored separately
+        return false;
+
+    // both the char and its trailing zero need to be in the nullified memory
+    if (!this->isNullByteAt(regData, off, fld)
+            || !this->isNullByteAt(regData, off + 1, fld))
+        return false;
+
+    IR::TInt num;
+    if (!this->charOfVal(&num, val))
+        return false;
+
+    const TObjType cltStr = stringTypeOf(fldData->clt, /* char + zero */ 2);
+    const TFldId str = this->fldCreate(obj, off, cltStr);
+    regData->liveFields[str] = BK_FIELD;
+
+    // the nullified block is split by setValueOf(), the char is read from str
+    const TValId valStr = this->wrapStringVal(std::string(1, num));
+    this->setValueOf(str, valStr, killedPtrs);
+    return true;
+}
+
+/// absorb the uniform blocks of the same value that overlap or touch the block
+void SymHeapCore::Private::mergeUniformBlock(const TFldId block)
+{
+    BlockEntity *blData;
+    this->ents.getEntRW(&blData, block);
+    CL_BREAK_IF(BK_UNIFORM != blData->code);
+
+    Region *regData;
+    this->ents.getEntRW(&regData, blData->obj);
+    CL_BREAK_IF(!this->chkArenaConsistency(regData));
+
+    // extend the window by one byte on both sides to catch adjacent blocks
+    TArena &arena = regData->arena;
+    TOffset beg = blData->off;
+    TOffset end = beg + blData->size;
+    const TMemChunk chunk(beg - 1, end + 1);
+
+    TFldIdSet overlaps;
+    if (!arenaLookup(&overlaps, arena, chunk, block))
+        return;
+
+    bool merged = false;
+    BOOST_FOREACH(const TFldId other, overlaps) {
+        const BlockEntity *otherData;
+        this->ents.getEntRO(&otherData, other);
+        if (BK_UNIFORM != otherData->code)
+            continue;
+
+        if (!hasKey(regData->liveFields, other))
+            continue;
+
+        if (!this->valsEqual(otherData->value, blData->value))
+            // different contents, keep both blocks
+            continue;
+
+        // take over the range of the other block and throw the block away
+        const TOffset otherBeg = otherData->off;
+        const TSizeOf otherSize = otherData->size;
+        beg = std::min(beg, otherBeg);
+        end = std::max(end, otherBeg + otherSize);
+
+        regData->liveFields.erase(other);
+        arena -= createArenaItem(otherBeg, otherSize, other);
+        this->ents.releaseEnt(other);
+        merged = true;
+    }
+
+    if (!merged)
+        return;
+
+    // remap the block
+    arena -= createArenaItem(blData->off, blData->size, block);
+    blData->off = beg;
+    blData->size = end - beg;
+    arena += createArenaItem(beg, blData->size, block);
+    CL_BREAK_IF(!this->chkArenaConsistency(regData));
+}
+
 void SymHeapCore::writeUniformBlock(
         const TObjId                obj,
         const UniformBlock         &ub,
         TValSet                    *killedPtrs)
 {
-    d->writeUniformBlock(obj, ub, killedPtrs);
+    const TFldId block = d->writeUniformBlock(obj, ub, killedPtrs);
+    if (FLD_INVALID != block)
+        // keep a single block for a sequence of memset() calls
+        d->mergeUniformBlock(block);
 }
 
 void SymHeapCore::copyBlockOfRawMemory(
@@ -2199,6 +2551,10 @@ bool SymHeapCore::Private::findZeroAtOff(
     // go through all intersections and find the zero that is closest to offSrc
     TOffset first = limit;
     BOOST_FOREACH(const TFldId fld, overlaps) {
+        if (!hasKey(rootData->liveFields, fld))
+            // a dead field only mirrors the live data that overlap it
+            continue;
+
         TOffset beg;
         if (!this->findZeroInBlock(&beg, &provenPrefix, offSrc, fld))
             // failed to imply zero in this block entity
@@ -2293,6 +2649,51 @@ TValId SymHeapCore::Private::wrapIntVal(const IR::TInt num)
     return valInt;
 }
 
+/// true if val is a known non-zero integral value, which is stored to *pDst
+bool SymHeapCore::Private::charOfVal(IR::TInt *pDst, const TValId val)
+{
+    if (val <= 0)
+        // VAL_NULL or a special value
+        return false;
+
+    const BaseValue *valData;
+    this->ents.getEntRO(&valData, val);
+    if (VT_CUSTOM != valData->code)
+        return false;
+
+    const InternalCustomValue *numData =
+        DCAST<const InternalCustomValue *>(valData);
+
+    const CustomValue &cv = numData->customData;
+    if (CV_INT_RANGE != cv.code())
+        return false;
+
+    const IR::Range &rng = cv.rng();
+    if (!isSingular(rng))
+        return false;
+
+    *pDst = rng.lo;
+    return true;
+}
+
+TValId SymHeapCore::Private::wrapStringVal(const std::string &str)
+{
+    // CV_STRING values are supposed to be reused if they exist already
+    RefCntLib<RCO_NON_VIRT>::requireExclusivity(this->cValueMap);
+    const CustomValue cvStr(str.c_str());
+    TValId &valStr = this->cValueMap->lookup(cvStr);
+
+    if (VAL_INVALID == valStr) {
+        // CV_STRING not found, wrap it as a new heap value
+        valStr = this->valCreate(VT_CUSTOM, VO_ASSIGNED);
+        InternalCustomValue *strData;
+        this->ents.getEntRW(&strData, valStr);
+        strData->customData = cvStr;
+    }
+
+    return valStr;
+}
+
 void SymHeapCore::Private::replaceRngByInt(const InternalCustomValue *valData)
 {
     CL_DEBUG("replaceRngByInt() is taking place...");
@@ -3498,8 +3899,49 @@ bool SymHeapCore::valString(TValId addr, std::string &str) {
         }
     }
 
-    // TODO: reinterpretation
-    return false;
+    if (!isPossibleToDeref(*this, addr))
+        return false;
+
+    // resolve root and offset
+    const BaseAddress *rootValData;
+    d->ents.getEntRO(&rootValData, valData->valRoot);
+    const Region *regData;
+    d->ents.getEntRO(&regData, rootValData->obj);
+    const TOffset off = valData->offRoot;
+
+    // look for a zero-terminated string stored in the region
+    const TFldId fld = d->liveBlockAt(regData, off, FLD_INVALID);
+    if (FLD_INVALID == fld)
+        return false;
+
+    const BlockEntity *blData;
+    d->ents.getEntRO(&blData, fld);
+    if (VAL_NULL == blData->value) {
+        // nullified memory is an empty string
+        str.clear();
+        return true;
+    }
+
+    if (BK_FIELD != blData->code
+            || !isString(DCAST<const FieldOfObj *>(blData)->clt)
+            || VT_CUSTOM != this->valTarget(blData->value))
+        return false;
+
+    const InternalCustomValue *strData;
+    d->ents.getEntRO(&strData, blData->value);
+    const CustomValue &cv = strData->customData;
+    if (CV_STRING != cv.code())
+        return false;
+
+    // the string is followed by zeros up to the end of the array
+    const TOffset pos = off - blData->off;
+    const std::string &whole = cv.str();
+    if (static_cast<TOffset>(whole.size()) <= pos)
+        str.clear();
+    else
+        str = whole.substr(pos);
+
+    return true;
 }
 
 TSizeRange SymHeapCore::valSizeOfString(TValId addr) const
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "symlower.hh"
+
+#include <cl/cldebug.hh>
+#include <cl/clutil.hh>
+#include <cl/storage.hh>
+
+#include <functional>
+#include <map>
+
+// /////////////////////////////////////////////////////////////////////////////
+// LoweredInsn implementation
+const LoweredOperand* LoweredInsn::find(const struct cl_operand &op) const
+{
+    const CodeStorage::TOperandList &opList = insn->operands;
+    const std::less<const struct cl_operand *> lt;
+    if (opList.empty() || lt(&op, &opList.front()) || lt(&opList.back(), &op))
+        // not an operand of this insn (an array index or a local copy)
+        return 0;
+
+    const LoweredOperand &lo = operands[&op - &opList.front()];
+    if (!lo.isVar)
+        return 0;
+
+    return &lo;
+}
+
+void lowerOperand(LoweredOperand &lo, const struct cl_operand &op)
+{
+    lo.isVar = (CL_OPERAND_VAR == op.code);
+    lo.uid = (lo.isVar)
+        ? varIdFromOperand(&op)
+        : /* invalid */ -1;
+
+    lo.isRef = seekRefAccessor(op.accessor);
+    lo.off = 0;
+
+    // check for dereference first
+    const struct cl_accessor *ac = op.accessor;
+    lo.isDeref = (ac && CL_ACCESSOR_DEREF == ac->code);
+    if (lo.isDeref)
+        ac = ac->next;
+
+    // fold the chain of accessors the same way SymProc::targetAt() does
+    for (; ac; ac = ac->next) {
+        const enum cl_accessor_e code = ac->code;
+        switch (code) {
+            case CL_ACCESSOR_REF:
+                continue;
+
+            case CL_ACCESSOR_DEREF:
+                CL_BREAK_IF("chaining of CL_ACCESSOR_DEREF not supported");
+                continue;
+
+            case CL_ACCESSOR_DEREF_ARRAY: {
+                const LoweredIndex li = {
+                    /* index    */ ac->data.array.index,
+                    /* itemSize */ targetTypeOfArray(ac->type)->size
+                };
+                lo.indexes.push_back(li);
+                continue;
+            }
+
+            case CL_ACCESSOR_ITEM: {
+                const int id = ac->data.item.id;
+                const struct cl_type *clt = ac->type;
+                CL_BREAK_IF(!clt || clt->item_cnt <= id);
+                lo.off += clt->items[id].offset;
+                continue;
+            }
+
+            case CL_ACCESSOR_OFFSET:
+                lo.off += ac->data.offset.off;
+                continue;
+        }
+    }
+}
+
+bool hasExplicitDeref(const struct cl_operand &op)
+{
+    // we expect the dereference only as the first accessor
+    const struct cl_accessor *ac = op.accessor;
+    if (!ac)
+        return false;
+
+    const enum cl_accessor_e code = ac->code;
+    switch (code) {
+        case CL_ACCESSOR_DEREF:
+        case CL_ACCESSOR_DEREF_ARRAY:
+            break;
+
+        default:
+            // no dereference in this operand
+            return false;
+    }
+
+    // if there is CL_ACCESSOR_REF, only an address is being computed
+    return !seekRefAccessor(ac);
+}
+
+void lowerInsnCore(LoweredInsn &li, const CodeStorage::Insn &insn)
+{
+    li.insn = &insn;
+
+    const CodeStorage::TOperandList &opList = insn.operands;
+    const unsigned cnt = opList.size();
+    li.operands.resize(cnt);
+
+    for (unsigned idx = 0; idx < cnt; ++idx) {
+        const struct cl_operand &op = opList[idx];
+        lowerOperand(li.operands[idx], op);
+        if (hasExplicitDeref(op))
+            li.derefs.push_back(idx);
+    }
+}
+
+class LoweredInsnTable {
+    public:
+        static LoweredInsnTable* inst() {
+            return (inst_)
+                ? (inst_)
+                : (inst_ = new LoweredInsnTable);
+        }
+
+        const LoweredInsn& lookup(const CodeStorage::Insn &insn) {
+            if (last_ && last_->insn == &insn)
+                // the same insn is usually executed for all heaps in a row
+                return *last_;
+
+            LoweredInsn &li = tbl_[&insn];
+            if (!li.insn)
+                // first request for this insn
+                lowerInsnCore(li, insn);
+
+            last_ = &li;
+            return li;
+        }
+
+    private:
+        typedef std::map<const CodeStorage::Insn *, LoweredInsn> TMap;
+
+        // singleton
+        LoweredInsnTable():
+            last_(0)
+        {
+        }
+
+        static LoweredInsnTable *inst_;
+
+        TMap tbl_;
+        const LoweredInsn *last_;
+};
+
+LoweredInsnTable *LoweredInsnTable::inst_;
+
+const LoweredInsn& lowerInsn(const CodeStorage::Insn &insn)
+{
+    return LoweredInsnTable::inst()->lookup(insn);
+}
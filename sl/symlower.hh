@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_SYM_LOWER_H
+#define H_GUARD_SYM_LOWER_H
+
+/**
+ * @file symlower.hh
+ * operands of CodeStorage::Insn lowered once, such that SymProc does not need
+ * to interpret the chain of cl_accessor objects on each execution of the insn
+ */
+
+#include "symbin.hh"                // for TOpIdxList
+#include "symheap.hh"               // for TOffset and TSizeOf
+
+#include <vector>
+
+namespace CodeStorage {
+    struct Insn;
+}
+
+/// CL_ACCESSOR_DEREF_ARRAY, the index of which needs to be read from the heap
+struct LoweredIndex {
+    const struct cl_operand        *index;      ///< operand holding the index
+    TSizeOf                         itemSize;   ///< size of an array item
+};
+
+typedef std::vector<LoweredIndex>                   TLoweredIndexList;
+
+/// operand with the chain of accessors resolved in advance
+struct LoweredOperand {
+    bool                            isVar;      ///< CL_OPERAND_VAR operand
+    cl_uid_t                        uid;        ///< uid of the variable
+    bool                            isDeref;    ///< starts by CL_ACCESSOR_DEREF
+    bool                            isRef;      ///< contains CL_ACCESSOR_REF
+    TOffset                         off;        ///< sum of constant offsets
+    TLoweredIndexList               indexes;    ///< in the order of accessors
+};
+
+/// all operands of an instruction lowered in advance
+struct LoweredInsn {
+    const CodeStorage::Insn        *insn;
+    std::vector<LoweredOperand>     operands;   ///< one per insn->operands
+    TOpIdxList                      derefs;     ///< operands with dereference
+
+    LoweredInsn():
+        insn(0)
+    {
+    }
+
+    /// return lowered CL_OPERAND_VAR operand of the insn, 0 if op is not one
+    const LoweredOperand* find(const struct cl_operand &op) const;
+};
+
+/// return the lowered form of the given insn, created on the first request
+const LoweredInsn& lowerInsn(const CodeStorage::Insn &insn);
+
+#endif /* H_GUARD_SYM_LOWER_H */
@@ -33,6 +33,7 @@
 #include "symbt.hh"
 #include "symgc.hh"
 #include "symheap.hh"
+#include "symlower.hh"
 #include "symplot.hh"
 #include "symseg.hh"
 #include "symstate.hh"
@@ -397,13 +398,25 @@ TObjId SymProc::objByVar(const CVar &cv, const bool initOnly)
     return reg;
 }
 
+const LoweredOperand* SymProc::loweredOf(const struct cl_operand &op) const
+{
+    if (!lowered_)
+        return 0;
+
+    return lowered_->find(op);
+}
+
 TObjId SymProc::objByVar(const struct cl_operand &op)
 {
     if (CL_OPERAND_VOID == op.code)
         return OBJ_INVALID;
 
     // resolve CVar
-    const cl_uid_t uid = varIdFromOperand(&op);
+    const LoweredOperand *lo = this->loweredOf(op);
+    const cl_uid_t uid = (lo)
+        ? lo->uid
+        : varIdFromOperand(&op);
+
     const int nestLevel = bt_->countOccurrencesOfTopFnc();
     const CVar cv(uid, nestLevel);
     return this->objByVar(cv);
@@ -435,8 +448,43 @@ TOffset offItem(const struct cl_accessor *ac)
     return clt->items[id].offset;
 }
 
+TValId SymProc::targetAt(const LoweredOperand &lo)
+{
+    // resolve program variable
+    const CVar cv(lo.uid, bt_->countOccurrencesOfTopFnc());
+    const TObjId obj = this->objByVar(cv);
+    TValId addr = sh_.addrOfTarget(obj, TS_REGION);
+
+    // constant offsets are already folded, read array indexes from the heap
+    TOffset off = lo.off;
+    BOOST_FOREACH(const LoweredIndex &li, lo.indexes) {
+        const TValId valIdx = this->valFromOperand(*li.index);
+
+        IR::TInt idx;
+        if (!numFromVal(&idx, sh_, valIdx))
+            // no clue how to compute the resulting offset
+            return sh_.valCreate(VT_UNKNOWN, VO_UNKNOWN);
+
+        off += idx * li.itemSize;
+    }
+
+    if (lo.isDeref) {
+        // read the value inside the pointer
+        const PtrHandle ptr(sh_, obj);
+        addr = ptr.value();
+    }
+
+    // apply the offset
+    return sh_.valByOffset(addr, off);
+}
+
 TValId SymProc::targetAt(const struct cl_operand &op)
 {
+    const LoweredOperand *lo = this->loweredOf(op);
+    if (lo)
+        // the chain of accessors has already been resolved
+        return this->targetAt(*lo);
+
     // resolve program variable
     const TObjId obj = this->objByVar(op);
     if (OBJ_INVALID == obj)
@@ -536,7 +584,8 @@ FldHandle SymProc::fldByOperand(const struct cl_operand &op)
 
 TValId SymProc::valFromObj(const struct cl_operand &op)
 {
-    if (seekRefAccessor(op.accessor))
+    const LoweredOperand *lo = this->loweredOf(op);
+    if ((lo) ? lo->isRef : seekRefAccessor(op.accessor))
         return this->targetAt(op);
 
     const FldHandle handle = this->fldByOperand(op);
@@ -2948,10 +2997,68 @@ bool SymExecCore::execCore(
     Trace::Node *trOrig = sh_.traceNode();
     Trace::Node *trInsn = new Trace::InsnNode(trOrig, &insn, /* bin */ false);
     sh_.traceUpdate(trInsn);
+
+    if (owned_) {
+        // we own the heap, so it can be moved to dst without cloning it
+        SymHeap *sh = owned_;
+        owned_ = 0;
+        dst.adopt(sh);
+        return true;
+    }
+
     dst.insert(sh_);
     return true;
 }
 
+TObjId SymExecCore::abstractTargetOf(
+        const struct cl_operand     &op,
+        ETargetSpecifier            *pTs)
+{
+    if (CL_OPERAND_VAR != op.code)
+        // literals cannot be abstract
+        return OBJ_INVALID;
+
+    // we expect a pointer at this point
+    const TObjId ptr = this->objByVar(op);
+    CL_BREAK_IF(!sh_.isValid(ptr));
+    if (sh_.objSize(ptr).lo < sh_.stor().types.dataPtrSizeof())
+        // not enough space to hold a pointer to data
+        return OBJ_INVALID;
+
+    // read the value inside the pointer
+    const TValId addr = valOfPtr(sh_, ptr, /* off */ 0);
+    if (!canWriteDataPtrAt(sh_, addr))
+        return OBJ_INVALID;
+
+    // resolve the target object of the address
+    const TObjId obj = sh_.objByAddr(addr);
+    CL_BREAK_IF(!sh_.isValid(obj));
+
+    // check whether the target is an abstract object
+    const EObjKind kind = sh_.objKind(obj);
+    if (OK_REGION == kind)
+        return OBJ_INVALID;
+
+    *pTs = sh_.targetSpec(addr);
+    return obj;
+}
+
+template <class TDerefs>
+bool SymExecCore::needsConcretization(
+        const CodeStorage::Insn     &insn,
+        const TDerefs               &derefs)
+{
+    BOOST_FOREACH(unsigned idx, derefs) {
+        ETargetSpecifier ts;
+        const struct cl_operand &op = insn.operands.at(idx);
+        if (OBJ_INVALID != this->abstractTargetOf(op, &ts))
+            return true;
+    }
+
+    // all dereferenced objects are concrete
+    return false;
+}
+
 template <class TDerefs>
 bool SymExecCore::concretizeLoop(
         SymState                    &dst,
@@ -2969,38 +3076,18 @@ bool SymExecCore::concretizeLoop(
         SymHeap &sh = todo.front();
         SymExecCore slave(sh, bt_, ep_);
         slave.setLocation(lw_);
+        slave.lowered_ = lowered_;
 
 #ifndef NDEBUG
         bool hitLocal = false;
 #endif
         BOOST_FOREACH(unsigned idx, derefs) {
             const struct cl_operand &op = insn.operands.at(idx);
-            if (CL_OPERAND_VAR != op.code)
-                // literals cannot be abstract
-                continue;
-
-            // we expect a pointer at this point
-            const TObjId ptr = slave.objByVar(op);
-            CL_BREAK_IF(!sh.isValid(ptr));
-            if (sh.objSize(ptr).lo < sh_.stor().types.dataPtrSizeof())
-                // not enough space to hold a pointer to data
-                continue;
-
-            // read the value inside the pointer
-            const TValId addr = valOfPtr(sh, ptr, /* off */ 0);
-            if (!canWriteDataPtrAt(sh, addr))
-                continue;
-
-            // resolve the target object of the address
-            const TObjId obj = sh.objByAddr(addr);
-            CL_BREAK_IF(!sh.isValid(obj));
-
-            // check whether the target is an abstract object
-            const EObjKind kind = sh.objKind(obj);
-            if (OK_REGION == kind)
+            ETargetSpecifier ts;
+            const TObjId obj = slave.abstractTargetOf(op, &ts);
+            if (OBJ_INVALID == obj)
                 continue;
 
-            const ETargetSpecifier ts = sh.targetSpec(addr);
 #ifndef NDEBUG
             CL_BREAK_IF(hitLocal);
             hitLocal = true;
@@ -3009,6 +3096,9 @@ bool SymExecCore::concretizeLoop(
             LeakMonitor lm(sh);
             lm.enter();
 
+            // the results are not memoized, the heaps entering a basic block
+            // are already unique up to isomorphism (see SymStateWithJoin), so
+            // the same heap is hardly ever concretized twice
             TObjSet leakObjs;
             concretizeObj(sh, todo, obj, ts, &leakObjs);
 
@@ -3040,6 +3130,9 @@ bool SymExecCore::concretizeLoop(
 
 bool SymExecCore::exec(SymState &dst, const CodeStorage::Insn &insn)
 {
+    // resolve the operands of the instruction only once, see symlower.hh
+    lowered_ = &lowerInsn(insn);
+
     TOpIdxList derefs;
 
     const cl_insn_e code = insn.code;
@@ -3047,33 +3140,12 @@ bool SymExecCore::exec(SymState &dst, const CodeStorage::Insn &insn)
         // certain built-ins dereference certain operands (free, memset, ...)
         derefs = opsWithDerefSemanticsInCallInsn(*this, insn);
 
-    // look for explicit dereferences in operands of the instruction
-    const CodeStorage::TOperandList &opList = insn.operands;
-    for (unsigned idx = 0; idx < opList.size(); ++idx) {
-        const struct cl_accessor *ac = opList[idx].accessor;
-        if (!ac)
-            continue;
-
-        // we expect the dereference only as the first accessor
-        const enum cl_accessor_e code = ac->code;
-        switch (code) {
-            case CL_ACCESSOR_DEREF:
-            case CL_ACCESSOR_DEREF_ARRAY:
-                break;
-
-            default:
-                // no dereference in this operand
-                continue;
-        }
-
-        if (seekRefAccessor(ac))
-            // not a dereference, only an address is being computed
-            continue;
-
-        derefs.push_back(idx);
-    }
+    // append explicit dereferences in operands of the instruction
+    const TOpIdxList &explicitDerefs = lowered_->derefs;
+    derefs.insert(derefs.end(), explicitDerefs.begin(), explicitDerefs.end());
 
-    if (derefs.empty())
+    if (derefs.empty() || !this->needsConcretization(insn, derefs))
+        // nothing to concretize, no need to clone the heap
         return this->execCore(dst, insn);
 
     // handle dereferences
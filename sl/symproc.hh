@@ -36,6 +36,9 @@
 
 class SymState;
 
+struct LoweredInsn;
+struct LoweredOperand;
+
 namespace GlConf {
     struct Options;
 }
@@ -104,7 +107,8 @@ class SymProc {
             sh_(heap),
             bt_(bt),
             lw_(0),
-            errorDetected_(false)
+            errorDetected_(false),
+            lowered_(0)
         {
         }
 
@@ -162,7 +166,11 @@ class SymProc {
         virtual void varInit(TObjId reg);
         friend void initGlVar(SymHeap &sh, const CVar &cv);
 
+        /// return lowered form of op if it is an operand of the lowered insn
+        const LoweredOperand* loweredOf(const struct cl_operand &op) const;
+
     private:
+        TValId targetAt(const LoweredOperand &lo);
         TValId valFromObj(const struct cl_operand &op);
         TValId valFromCst(const struct cl_operand &op);
         void killVar(const CodeStorage::KillVar &kv);
@@ -172,6 +180,9 @@ class SymProc {
         const SymBackTrace          *bt_;
         const struct cl_loc         *lw_;
         bool                         errorDetected_;
+
+        /// operands of the insn being executed, see symlower.hh
+        const LoweredInsn           *lowered_;
 };
 
 /// @todo make the API more generic and better documented
@@ -222,10 +233,30 @@ class SymExecCore: public SymProc {
         SymExecCore(SymHeap &heap, const SymBackTrace *bt,
                     const SymExecCoreParams &ep = SymExecCoreParams()):
             SymProc(heap, bt),
-            ep_(ep)
+            ep_(ep),
+            owned_(0)
         {
         }
 
+        /**
+         * @param heap symbolic heap to operate on, the ownership is taken over
+         * @param ep execution parameters - see SymExecCoreParams for details
+         * @note the heap is executed in place: unless the instruction forks
+         * the state, the heap is moved (not cloned) to the resulting state,
+         * otherwise it is destroyed together with the SymExecCore object
+         */
+        SymExecCore(SymHeap *heap, const SymBackTrace *bt,
+                    const SymExecCoreParams &ep = SymExecCoreParams()):
+            SymProc(*heap, bt),
+            ep_(ep),
+            owned_(heap)
+        {
+        }
+
+        virtual ~SymExecCore() {
+            delete owned_;
+        }
+
         const SymExecCoreParams& params() const { return ep_; }
 
     public:
@@ -267,6 +298,13 @@ class SymExecCore: public SymProc {
         template <int ARITY>
         void execOp(const CodeStorage::Insn &insn);
 
+        TObjId abstractTargetOf(const struct cl_operand &op,
+                                ETargetSpecifier *pTs);
+
+        template <class TDerefs>
+        bool needsConcretization(const CodeStorage::Insn &insn,
+                                 const TDerefs &derefs);
+
         template <class TDerefs>
         bool concretizeLoop(SymState &dst, const CodeStorage::Insn &insn,
                             const TDerefs &derefs);
@@ -282,8 +320,14 @@ class SymExecCore: public SymProc {
     protected:
         virtual void varInit(TObjId reg);
 
+    private:
+        // copying of SymExecCore objects is not supported
+        SymExecCore(const SymExecCore &);
+        SymExecCore& operator=(const SymExecCore &);
+
     private:
         const SymExecCoreParams ep_;
+        SymHeap                *owned_;
 };
 
 #endif /* H_GUARD_SYM_PROC_H */
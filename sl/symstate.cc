@@ -108,6 +108,14 @@ void SymState::insertNew(const SymHeap &sh)
     heaps_.push_back(dup);
 }
 
+bool SymState::adopt(SymHeap *sh, bool allowThreeWay)
+{
+    // the default implementation clones the heap on insertion
+    const bool changed = this->insert(*sh, allowThreeWay);
+    delete sh;
+    return changed;
+}
+
 bool SymState::insert(const SymHeap &sh, bool /* allowThreeWay */ )
 {
     if (-1 != this->lookup(sh))
@@ -168,13 +176,84 @@ void SymState::updateTraceOf(const int idx, Trace::Node *tr, EJoinStatus status)
 
 // /////////////////////////////////////////////////////////////////////////////
 // SymHeapUnion implementation
+size_t SymHeapUnion::hashOf(const int nth) const
+{
+    for (int idx = hashes_.size(); idx <= nth; ++idx)
+        hashes_.push_back(canonicalHash(this->operator[](idx)));
+
+    return hashes_[nth];
+}
+
+void SymHeapUnion::swap(SymState &other)
+{
+    SymState::swap(other);
+
+    SymHeapUnion *otherUnion = dynamic_cast<SymHeapUnion *>(&other);
+    if (otherUnion)
+        // the hashes go along with the heaps
+        hashes_.swap(otherUnion->hashes_);
+    else
+        hashes_.clear();
+}
+
+void SymHeapUnion::swapExisting(const int nth, SymHeap &sh)
+{
+    SymState::swapExisting(nth, sh);
+
+    if (nth < static_cast<int>(hashes_.size()))
+        hashes_[nth] = canonicalHash(this->operator[](nth));
+}
+
+void SymHeapUnion::rotateExisting(const int idxA, const int idxB)
+{
+    if (!hashes_.empty())
+        // complete the hashes, so that they can be rotated with the heaps
+        this->hashOf(this->size() - 1);
+
+    SymState::rotateExisting(idxA, idxB);
+    if (hashes_.empty())
+        return;
+
+    THashList::iterator itA = hashes_.begin() + idxA;
+    THashList::iterator itB = hashes_.begin() + idxB;
+    rotate(itA, itB, hashes_.end());
+}
+
 int SymHeapUnion::lookup(const SymHeap &lookFor) const
 {
-    const int cnt = this->size();
-    if (!cnt)
+    if (!this->size())
         // empty state --> not found
         return -1;
 
+    return this->lookupCore(lookFor, canonicalHash(lookFor));
+}
+
+bool SymHeapUnion::insert(const SymHeap &sh, bool /* allowThreeWay */ )
+{
+    if (!this->size()) {
+        // nothing to compare with, the hash is computed once it is needed
+        this->insertNew(sh);
+        return true;
+    }
+
+    const size_t hash = canonicalHash(sh);
+    if (-1 != this->lookupCore(sh, hash))
+        return false;
+
+    // add given heap to union
+    this->insertNew(sh);
+
+    if (hashes_.size() + 1U == this->size())
+        // we already know the hash of the appended heap
+        hashes_.push_back(hash);
+
+    return true;
+}
+
+int SymHeapUnion::lookupCore(const SymHeap &lookFor, const size_t hash) const
+{
+    const int cnt = this->size();
+
     ++::cntLookups;
     debugPlot("lookup", 0, lookFor);
 
@@ -184,6 +263,12 @@ int SymHeapUnion::lookup(const SymHeap &lookFor) const
         const SymHeap &sh = this->operator[](idx);
         debugPlot("lookup", nth, sh);
 
+        if (this->hashOf(idx) != hash) {
+            // different canonical form, the heaps cannot be isomorphic
+            CL_BREAK_IF(areEqual(lookFor, sh));
+            continue;
+        }
+
         if (areEqual(lookFor, sh)) {
             CL_DEBUG("<I> sh #" << idx << " is equal to the given one, "
                     << cnt << " heaps in total");
@@ -560,7 +645,7 @@ void SymStateMarked::swap(SymState &other)
 
 void SymStateMarked::rotateExisting(const int idxA, const int idxB)
 {
-    SymState::rotateExisting(idxA, idxB);
+    SymStateWithJoin::rotateExisting(idxA, idxB);
 
     TDone::iterator itA = done_.begin() + idxA;
     TDone::iterator itB = done_.begin() + idxB;
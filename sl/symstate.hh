@@ -65,6 +65,13 @@ class SymState {
         /// insert given SymHeap object into the state
         virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
 
+        /**
+         * insert given SymHeap object into the state, the state takes over the
+         * ownership of the object (it may be destroyed right away if the state
+         * already covers it)
+         */
+        virtual bool adopt(SymHeap *sh, bool allowThreeWay = true);
+
         /// return count of object stored in the container
         size_t size()          const { return heaps_.size();  }
 
@@ -89,6 +96,18 @@ class SymState {
         /// insert @b new SymHeap that @ must be guaranteed to be not yet in
         virtual void insertNew(const SymHeap &sh);
 
+        /// append the given SymHeap object to the container without cloning
+        void adoptNew(SymHeap *sh) {
+            heaps_.push_back(sh);
+        }
+
+        /// take the nth SymHeap object out of the container, leave the slot empty
+        SymHeap* releaseExisting(int nth) {
+            SymHeap *sh = heaps_[nth];
+            heaps_[nth] = 0;
+            return sh;
+        }
+
         virtual void eraseExisting(int nth) {
             delete heaps_[nth];
             heaps_.erase(heaps_.begin() + nth);
@@ -130,6 +149,22 @@ class SymHeapList: public SymState {
         virtual int lookup(const SymHeap &) const {
             return /* not found */ -1;
         }
+
+        /// the list does not look for duplicates, so the object is just appended
+        virtual bool adopt(SymHeap *sh, bool /* allowThreeWay */ = true) {
+            this->adoptNew(sh);
+            return true;
+        }
+
+        /**
+         * hand out the nth SymHeap object without cloning it, the caller takes
+         * over the ownership of the object
+         * @attention the nth slot is left empty and must not be accessed until
+         * the list is cleared or overwritten
+         */
+        SymHeap* release(int nth) {
+            return this->releaseExisting(nth);
+        }
 };
 
 /**
@@ -143,7 +178,40 @@ class SymHeapList: public SymState {
  */
 class SymHeapUnion: public SymState {
     public:
+        virtual void clear() {
+            SymState::clear();
+            hashes_.clear();
+        }
+
+        virtual void swap(SymState &other);
+
         virtual int lookup(const SymHeap &sh) const;
+
+        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
+
+    protected:
+        virtual void eraseExisting(int nth) {
+            SymState::eraseExisting(nth);
+
+            if (nth < static_cast<int>(hashes_.size()))
+                hashes_.erase(hashes_.begin() + nth);
+        }
+
+        virtual void swapExisting(int nth, SymHeap &sh);
+
+        virtual void rotateExisting(int idxA, int idxB);
+
+        /// lookup/insert optimization in SymCallCache implementation
+        friend class PerFncCache;
+
+    private:
+        typedef std::vector<size_t> THashList;
+
+        /// canonicalHash() of the leading heaps, the rest is computed lazily
+        mutable THashList hashes_;
+
+        size_t hashOf(int nth) const;
+        int lookupCore(const SymHeap &sh, size_t hash) const;
 };
 
 class SymStateWithJoin: public SymHeapUnion {
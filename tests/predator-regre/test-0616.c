@@ -0,0 +1,22 @@
+#include <verifier-builtins.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int main()
+{
+    char *buf = calloc(16U, sizeof *buf);
+    if (!buf)
+        abort();
+
+    /* build the string char by char in the nullified memory */
+    int i;
+    for (i = 0; i < 7; ++i)
+        buf[i] = 'a' + i;
+
+    __VERIFIER_assert(7U == strlen(buf));
+    __VERIFIER_assert(!strcmp(buf, "abcdefg"));
+
+    free(buf);
+    return 0;
+}
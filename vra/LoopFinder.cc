@@ -1150,7 +1150,13 @@ void LoopFinder::computeLoopAnalysis(const CodeStorage::Storage &stor)
 */
 unsigned long LoopFinder::getUpperLimit(const Block *block)
 {
-	return LoopFinder::blockToUpperLimit[block];
+	// The limits are read by several threads, so nothing may be inserted here.
+	BlockToUpperLimit::const_iterator it = LoopFinder::blockToUpperLimit.find(block);
+	if (it == LoopFinder::blockToUpperLimit.end()) {
+		return 0;
+	}
+
+	return it->second;
 }
 
 /**
@@ -8,6 +8,8 @@
 #include <iostream>
 #include "MemoryPlace.h"
 
+unsigned MemoryPlace::count = 0;
+
 /**
 * @brief Returns @c true if the current memory place represents an element of an
 *        array (it could be arbitrarily nested in structure), @c false otherwise.
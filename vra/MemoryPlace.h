@@ -21,10 +21,18 @@ class MemoryPlace {
 		std::string name;
 		bool artificial;
 
+		/// Unique number of the memory place.
+		unsigned id;
+
+		/// Number of created memory places, memory places may be created by
+		/// several threads.
+		static unsigned count;
+
 	public:
 		/// Creates new memory place.
 		MemoryPlace(std::string name, bool artificial): name(name),
-														artificial(artificial) {}
+														artificial(artificial),
+														id(__sync_fetch_and_add(&count, 1)) {}
 
 		/// Returns the name of the memory place (as it is represented in a
 		// program).
@@ -34,6 +42,10 @@ class MemoryPlace {
 		/// otehrwise.
 		bool isArtificial() const    { return artificial; }
 
+		/// Returns the unique number of the memory place. Memory places are
+		/// numbered from zero in the order of their creation.
+		unsigned getId() const       { return id; }
+
 		bool representsElementOfArray() const;
 };
 
@@ -42,6 +42,347 @@ namespace {
 
 }
 
+/**
+* @brief Constructs a new integral value.
+*/
+Number::IntValue::IntValue(int value)
+		:kind(LONG), longValue(value), ulongValue(0), bigValue(0) {}
+
+/**
+* @brief Constructs a new integral value.
+*/
+Number::IntValue::IntValue(unsigned value)
+		:kind(LONG), longValue(value), ulongValue(0), bigValue(0) {}
+
+/**
+* @brief Constructs a new integral value.
+*/
+Number::IntValue::IntValue(long value)
+		:kind(LONG), longValue(value), ulongValue(0), bigValue(0) {}
+
+/**
+* @brief Constructs a new integral value.
+*/
+Number::IntValue::IntValue(unsigned long value)
+		:kind(LONG), longValue(0), ulongValue(0), bigValue(0)
+{
+	setULong(value);
+}
+
+/**
+* @brief Constructs a new integral value.
+*/
+Number::IntValue::IntValue(const Int &value)
+		:kind(LONG), longValue(0), ulongValue(0), bigValue(0)
+{
+	set(value);
+}
+
+/**
+* @brief Constructs a copy of @a other.
+*/
+Number::IntValue::IntValue(const IntValue &other)
+		:kind(other.kind), longValue(other.longValue),
+		ulongValue(other.ulongValue),
+		bigValue(other.bigValue ? new Int(*other.bigValue) : 0) {}
+
+/**
+* @brief Destructs the value.
+*/
+Number::IntValue::~IntValue()
+{
+	delete bigValue;
+}
+
+/**
+* @brief Assigns @a other into the current value.
+*/
+Number::IntValue &Number::IntValue::operator=(const IntValue &other)
+{
+	if (this == &other)
+		return *this;
+
+	if (other.bigValue) {
+		if (bigValue)
+			*bigValue = *other.bigValue;
+		else
+			bigValue = new Int(*other.bigValue);
+	} else {
+		delete bigValue;
+		bigValue = 0;
+	}
+	kind = other.kind;
+	longValue = other.longValue;
+	ulongValue = other.ulongValue;
+	return *this;
+}
+
+/**
+* @brief Sets the value to @a value, stores it inline if it fits.
+*/
+void Number::IntValue::set(const Int &value)
+{
+	if (mpz_fits_slong_p(value.get_mpz_t())) {
+		*this = IntValue(value.get_si());
+	} else if (mpz_fits_ulong_p(value.get_mpz_t())) {
+		*this = IntValue(value.get_ui());
+	} else {
+		if (bigValue)
+			*bigValue = value;
+		else
+			bigValue = new Int(value);
+		kind = BIG;
+	}
+}
+
+/**
+* @brief Sets the value to @a value.
+*/
+void Number::IntValue::setULong(unsigned long value)
+{
+	delete bigValue;
+	bigValue = 0;
+	if (value <= static_cast<unsigned long>(LONG_MAX)) {
+		kind = LONG;
+		longValue = static_cast<long>(value);
+	} else {
+		kind = ULONG;
+		ulongValue = value;
+	}
+}
+
+/**
+* @brief Returns @c true if the value fits into @c long, @c false otherwise.
+*/
+bool Number::IntValue::isLong() const
+{
+	return kind == LONG;
+}
+
+/**
+* @brief Returns the value that fits into @c long.
+*/
+long Number::IntValue::getLong() const
+{
+	assert(isLong());
+	return longValue;
+}
+
+/**
+* @brief Returns the value as @c Int.
+*/
+Number::Int Number::IntValue::get() const
+{
+	switch (kind) {
+		case LONG:
+			return Int(longValue);
+
+		case ULONG:
+			return Int(ulongValue);
+
+		default:
+			return *bigValue;
+	}
+}
+
+/**
+* @brief Returns the value as @c long, in the same way as @c mpz_get_si().
+*/
+long Number::IntValue::toLong() const
+{
+	switch (kind) {
+		case LONG:
+			return longValue;
+
+		case ULONG:
+			return mpz_get_si(get().get_mpz_t());
+
+		default:
+			return mpz_get_si(bigValue->get_mpz_t());
+	}
+}
+
+/**
+* @brief Returns the value as @c unsigned @c long, in the same way as
+*        @c mpz_get_ui().
+*/
+unsigned long Number::IntValue::toULong() const
+{
+	switch (kind) {
+		case LONG:
+			// mpz_get_ui() returns the absolute value.
+			return longValue >= 0 ? static_cast<unsigned long>(longValue) :
+				-static_cast<unsigned long>(longValue);
+
+		case ULONG:
+			return ulongValue;
+
+		default:
+			return mpz_get_ui(bigValue->get_mpz_t());
+	}
+}
+
+/**
+* @brief Compares the value with @a other, returns a negative number, zero, or
+*        a positive number like @c mpz_cmp().
+*/
+int Number::IntValue::compare(const IntValue &other) const
+{
+	if (kind == LONG && other.kind == LONG) {
+		return (longValue > other.longValue) - (longValue < other.longValue);
+	} else if (kind == ULONG && other.kind == ULONG) {
+		return (ulongValue > other.ulongValue) - (ulongValue < other.ulongValue);
+	} else if (kind == LONG && other.kind == ULONG) {
+		return -1;
+	} else if (kind == ULONG && other.kind == LONG) {
+		return 1;
+	}
+	return cmp(get(), other.get());
+}
+
+bool Number::IntValue::operator==(const IntValue &other) const
+{
+	return compare(other) == 0;
+}
+
+bool Number::IntValue::operator!=(const IntValue &other) const
+{
+	return compare(other) != 0;
+}
+
+bool Number::IntValue::operator<(const IntValue &other) const
+{
+	return compare(other) < 0;
+}
+
+bool Number::IntValue::operator>(const IntValue &other) const
+{
+	return compare(other) > 0;
+}
+
+bool Number::IntValue::operator<=(const IntValue &other) const
+{
+	return compare(other) <= 0;
+}
+
+bool Number::IntValue::operator>=(const IntValue &other) const
+{
+	return compare(other) >= 0;
+}
+
+Number::IntValue Number::IntValue::operator-() const
+{
+	if (kind == LONG && longValue != LONG_MIN)
+		return IntValue(-longValue);
+	return IntValue(Int(-get()));
+}
+
+Number::IntValue Number::IntValue::operator~() const
+{
+	if (kind == LONG)
+		return IntValue(~longValue);
+	Int result;
+	mpz_com(result.get_mpz_t(), get().get_mpz_t());
+	return IntValue(result);
+}
+
+Number::IntValue Number::IntValue::operator+(const IntValue &other) const
+{
+	long result;
+	if (kind == LONG && other.kind == LONG &&
+			!__builtin_add_overflow(longValue, other.longValue, &result))
+		return IntValue(result);
+	return IntValue(Int(get() + other.get()));
+}
+
+Number::IntValue Number::IntValue::operator-(const IntValue &other) const
+{
+	long result;
+	if (kind == LONG && other.kind == LONG &&
+			!__builtin_sub_overflow(longValue, other.longValue, &result))
+		return IntValue(result);
+	return IntValue(Int(get() - other.get()));
+}
+
+Number::IntValue Number::IntValue::operator*(const IntValue &other) const
+{
+	long result;
+	if (kind == LONG && other.kind == LONG &&
+			!__builtin_mul_overflow(longValue, other.longValue, &result))
+		return IntValue(result);
+	return IntValue(Int(get() * other.get()));
+}
+
+/**
+* @brief Integral division, the result is rounded to zero (like for @c Int).
+*/
+Number::IntValue Number::IntValue::operator/(const IntValue &other) const
+{
+	if (kind == LONG && other.kind == LONG && other.longValue != 0 &&
+			!(longValue == LONG_MIN && other.longValue == -1))
+		return IntValue(longValue / other.longValue);
+	return IntValue(Int(get() / other.get()));
+}
+
+/**
+* @brief Remainder of the integral division, it has the sign of the dividend
+*        (like for @c Int).
+*/
+Number::IntValue Number::IntValue::operator%(const IntValue &other) const
+{
+	if (kind == LONG && other.kind == LONG && other.longValue != 0 &&
+			other.longValue != -1)
+		return IntValue(longValue % other.longValue);
+	return IntValue(Int(get() % other.get()));
+}
+
+Number::IntValue Number::IntValue::operator&(const IntValue &other) const
+{
+	if (kind == LONG && other.kind == LONG)
+		return IntValue(longValue & other.longValue);
+	Int result;
+	mpz_and(result.get_mpz_t(), get().get_mpz_t(), other.get().get_mpz_t());
+	return IntValue(result);
+}
+
+Number::IntValue Number::IntValue::operator|(const IntValue &other) const
+{
+	if (kind == LONG && other.kind == LONG)
+		return IntValue(longValue | other.longValue);
+	Int result;
+	mpz_ior(result.get_mpz_t(), get().get_mpz_t(), other.get().get_mpz_t());
+	return IntValue(result);
+}
+
+Number::IntValue Number::IntValue::operator^(const IntValue &other) const
+{
+	if (kind == LONG && other.kind == LONG)
+		return IntValue(longValue ^ other.longValue);
+	Int result;
+	mpz_xor(result.get_mpz_t(), get().get_mpz_t(), other.get().get_mpz_t());
+	return IntValue(result);
+}
+
+/**
+* @brief Emits the value into @a os.
+*/
+void Number::IntValue::print(ostream &os) const
+{
+	switch (kind) {
+		case LONG:
+			os << longValue;
+			break;
+
+		case ULONG:
+			os << ulongValue;
+			break;
+
+		default:
+			os << *bigValue;
+			break;
+	}
+}
+
 /**
 * @brief Constructs a new number from integral value.
 *
@@ -56,6 +397,34 @@ Number::Number(Int value, unsigned width, bool sign)
 	fitIntoBitWidth();
 }
 
+/**
+* @brief Constructs a new number from integral value.
+*
+* Values of all integral C types can be passed without GMP. Unsigned values
+* above @c LONG_MAX are converted to negative numbers but this does not change
+* the result because the value is fitted into the bit width modulo its range.
+*
+* @param[in] value Instance of this class will represent this @a value.
+* @param[in] width Bit width of the type that was used to store @a value.
+* @param[in] sign Boolean flag specifies if the type is signed or unsigned.
+*/
+Number::Number(long value, unsigned width, bool sign)
+		:type(INT), intValue(value), sign(sign), bitWidth(width)
+{
+	setIntLimits();
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new number from integral value.
+*/
+Number::Number(const IntValue &value, unsigned width, bool sign)
+		:type(INT), intValue(value), sign(sign), bitWidth(width)
+{
+	setIntLimits();
+	fitIntoBitWidth();
+}
+
 /**
 * @brief Constructs a new number from floating-point value.
 *
@@ -402,7 +771,7 @@ Number Number::getNegativeInf() const
 Number::Int Number::getInt() const
 {
 	assert(isIntegral());
-	return intValue;
+	return intValue.get();
 }
 
 /**
@@ -463,8 +832,18 @@ void Number::integralPromotion()
 void Number::convertSignedToUnsigned()
 {
 	if (intValue < 0) {
-		Int max = maxIntLimit + 1;
-		Int tmp = -(intValue / max) + 1;
+		if (intValue.isLong()) {
+			// Values of signed types are converted modulo the range of the
+			// unsigned type, i.e. by keeping their lower bits.
+			unsigned long value = intValue.getLong();
+			if (getNumOfBits() < sizeof(long) * CHAR_BIT)
+				value &= (1UL << getNumOfBits()) - 1;
+			intValue = value;
+			return;
+		}
+
+		IntValue max = maxIntLimit + 1;
+		IntValue tmp = -(intValue / max) + 1;
 		intValue = intValue + tmp * max;
 	}
 }
@@ -602,21 +981,51 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 	}
 }
 
+/**
+* @brief Converts the given integer into a floating-point number.
+*
+* @param n Integer to be converted.
+* @param isSigned @c true if the integer is signed, @c false otherwise.
+*/
+Number::Float Number::intToFloat(const IntValue &n, bool isSigned) {
+	if (isSigned) {
+		return Float(n.toLong());
+	} else {
+		return Float(n.toULong());
+	}
+}
+
 /**
 * @brief According to the type of the number, converts its value to the predefined
 *        limits.
 */
 void Number::fitIntoBitWidth()
 {
-	if (isIntegral()) {
+	if (isIntegral() && intValue.isLong()) {
+		// The value is fitted modulo the range of the type, i.e. only its
+		// lower bits are kept (and interpreted as signed or unsigned).
+		const unsigned bits = getNumOfBits();
+		unsigned long value = intValue.getLong();
+		if (bits < sizeof(long) * CHAR_BIT) {
+			value &= (1UL << bits) - 1;
+			if (isSigned() && value >> (bits - 1)) {
+				intValue = static_cast<long>(value) - (1L << bits);
+				return;
+			}
+		} else if (isSigned()) {
+			return;
+		}
+		intValue = value;
+	} else if (isIntegral()) {
 		if (isSigned()) {
-			Int valuesInBitWidth = 2 * maxIntLimit + 2;
-			intValue -= minIntLimit;
+			IntValue valuesInBitWidth = maxIntLimit * 2 + 2;
+			intValue = intValue - minIntLimit;
 			if (intValue < 0) {
-				intValue += (-intValue / valuesInBitWidth + 1) * valuesInBitWidth;
+				intValue = intValue +
+					(-intValue / valuesInBitWidth + 1) * valuesInBitWidth;
 			}
-			intValue %= valuesInBitWidth;
-			intValue += minIntLimit;
+			intValue = intValue % valuesInBitWidth;
+			intValue = intValue + minIntLimit;
 		} else {
 			convertSignedToUnsigned();
 			intValue = intValue % (maxIntLimit + 1);
@@ -852,7 +1261,7 @@ Number operator+(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue + n2.intValue;
+		Number::IntValue newValue = n1.intValue + n2.intValue;
 		Number result(newValue, n1.bitWidth, n1.sign);
 		result.fitIntoBitWidth();
 		return result;
@@ -901,7 +1310,7 @@ Number operator-(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue - n2.intValue;
+		Number::IntValue newValue = n1.intValue - n2.intValue;
 		Number result(newValue, n1.bitWidth, n1.sign);
 		result.fitIntoBitWidth();
 		return result;
@@ -950,7 +1359,7 @@ Number operator*(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue * n2.intValue;
+		Number::IntValue newValue = n1.intValue * n2.intValue;
 		Number result(newValue, n1.bitWidth, n1.sign);
 		result.fitIntoBitWidth();
 		return result;
@@ -1031,7 +1440,7 @@ Number exact_div(const Number& op1, const Number& op2)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int newValue = n1.intValue / n2.intValue;
+	Number::IntValue newValue = n1.intValue / n2.intValue;
 	Number result(newValue, n1.bitWidth, n1.sign);
 	result.fitIntoBitWidth();
 
@@ -1061,54 +1470,39 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	Number &n2 = r.second;
 
 	// Performs operation on the C integral type.
-	Number::Int res;
-	if ((sizeof(int) == n1.bitWidth)) {
-		if (n1.isSigned()) {
-			int oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
-			if (isMod) {
-				// Computes modulo.
-				res = oper1 % oper2;
-			} else {
-				// Computes integral division.
-				res = oper1 / oper2;
-			}
+	Number::IntValue res;
+	if (n1.isSigned()) {
+		// The minimal value divided by -1 overflows the signed C type (and
+		// traps), so the operation is computed on IntValue, which rounds
+		// to zero in the same way. The result is fitted below.
+		if (isMod) {
+			// Computes modulo.
+			res = n1.intValue % n2.intValue;
 		} else {
-			unsigned oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
-			if (isMod) {
-				// Computes modulo.
-				res = oper1 % oper2;
-			} else {
-				// Computes integral division.
-				res = oper1 / oper2;
-			}
+			// Computes integral division.
+			res = n1.intValue / n2.intValue;
+		}
+	} else if ((sizeof(int) == n1.bitWidth)) {
+		unsigned oper1, oper2;
+		oper1 = n1.intValue.toULong();
+		oper2 = n2.intValue.toULong();
+		if (isMod) {
+			// Computes modulo.
+			res = oper1 % oper2;
+		} else {
+			// Computes integral division.
+			res = oper1 / oper2;
 		}
 	} else if ((sizeof(long) == n1.bitWidth)) {
-		if (n1.isSigned()) {
-			long oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
-			if (isMod) {
-				// Computes modulo.
-				res = oper1 % oper2;
-			} else {
-				// Computes integral division.
-				res = oper1 / oper2;
-			}
+		unsigned long oper1, oper2;
+		oper1 = n1.intValue.toULong();
+		oper2 = n2.intValue.toULong();
+		if (isMod) {
+			// Computes modulo.
+			res = oper1 % oper2;
 		} else {
-			unsigned long oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
-			if (isMod) {
-				// Computes modulo.
-				res = oper1 % oper2;
-			} else {
-				// Computes integral division.
-				res = oper1 / oper2;
-			}
+			// Computes integral division.
+			res = oper1 / oper2;
 		}
 	}
 
@@ -1200,8 +1594,7 @@ Number bitNot(const Number& op)
 
 	Number promotedOp = op;
 	promotedOp.integralPromotion();
-	Number::Int result;
-	mpz_com(result.get_mpz_t(), promotedOp.intValue.get_mpz_t());
+	Number::IntValue result = ~promotedOp.intValue;
 
 	return Number(result, promotedOp.bitWidth, promotedOp.sign);
 }
@@ -1228,24 +1621,21 @@ Number Number::performBitOp(const Number &op1, const Number &op2, char mode)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int res;
+	Number::IntValue res;
 	switch (mode) {
 		case 'A':
 			// Performs bit and.
-			mpz_and(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue & n2.intValue;
 			break;
 
 		case 'O':
 			// Performs bit or.
-			mpz_ior(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue | n2.intValue;
 			break;
 
 		case 'X':
 			// Performs bit xor.
-			mpz_xor(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue ^ n2.intValue;
 			break;
 	}
 
@@ -1296,33 +1686,33 @@ Number Number::performShift(Number op1, Number op2, bool isLeft)
 	// Bit shift is performed only if op2 is lower than the number of bits of
 	// the op1's type. This is not true for the C language. Thus, approximation
 	// is used in the Range class. It must be after integralPromotion()!
-	assert(op1.bitWidth * CHAR_BIT > op2.intValue);
+	assert(Number::IntValue(op1.bitWidth * CHAR_BIT) > op2.intValue);
 
 	// Shift are not defined for Int, so we have to use left shift from C.
 	// We have to store Int values into C types.
-	Number::Int res;
+	Number::IntValue res;
 	if ((sizeof(int) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			int signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue.toLong();
+			signedOP2 = op2.intValue.toLong();
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue.toULong();
+			signedOP2 = op2.intValue.toULong();
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	} else if ((sizeof(long) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			long signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue.toLong();
+			signedOP2 = op2.intValue.toLong();
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned long signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = op1.intValue.toULong();
+			signedOP2 = op2.intValue.toULong();
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	}
@@ -1382,9 +1772,9 @@ Number intToFloat(const Number& op)
 {
 	assert(op.isIntegral());
 	if (op.sign) {
-		return Number((float) mpz_get_si(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) op.intValue.toLong(), sizeof(float));
 	} else {
-		return Number((float) mpz_get_ui(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) op.intValue.toULong(), sizeof(float));
 	}
 }
 
@@ -1428,7 +1818,7 @@ Number max(const Number &op1, const Number &op2)
 ostream& operator<<(ostream &os, const Number &n)
 {
 	if (n.isIntegral())
-		os << n.intValue;
+		n.intValue.print(os);
 	else if (n.isFloatingPoint()) {
 		os << n.floatValue;
 	}
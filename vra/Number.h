@@ -37,11 +37,75 @@ class Number {
 		/// Biggest float.
 		typedef long double Float;
 
+		/**
+		* @brief Integral value that is stored inline if it fits into @c long
+		*        or @c unsigned @c long, and by GMP otherwise.
+		*
+		* Values of all C integral types fit, so GMP is used only for
+		* intermediate results that overflow (before they are fitted into the
+		* bit width of the number). Operations on values stored inline are
+		* checked for overflow and fall back to GMP only if it happens.
+		*/
+		class IntValue {
+			private:
+				/// Where the value is stored.
+				enum Kind {
+					LONG,   ///< in @c longValue
+					ULONG,  ///< in @c ulongValue, the value is above @c LONG_MAX
+					BIG     ///< in @c bigValue
+				};
+
+				Kind kind;
+				long longValue;
+				unsigned long ulongValue;
+				Int *bigValue;
+
+				void set(const Int &value);
+				void setULong(unsigned long value);
+				int compare(const IntValue &other) const;
+
+			public:
+				IntValue(int value = 0);
+				IntValue(unsigned value);
+				IntValue(long value);
+				IntValue(unsigned long value);
+				IntValue(const Int &value);
+				IntValue(const IntValue &other);
+				~IntValue();
+				IntValue &operator=(const IntValue &other);
+
+				bool isLong() const;
+				long getLong() const;
+				Int get() const;
+				long toLong() const;
+				unsigned long toULong() const;
+
+				bool operator==(const IntValue &other) const;
+				bool operator!=(const IntValue &other) const;
+				bool operator<(const IntValue &other) const;
+				bool operator>(const IntValue &other) const;
+				bool operator<=(const IntValue &other) const;
+				bool operator>=(const IntValue &other) const;
+
+				IntValue operator-() const;
+				IntValue operator~() const;
+				IntValue operator+(const IntValue &other) const;
+				IntValue operator-(const IntValue &other) const;
+				IntValue operator*(const IntValue &other) const;
+				IntValue operator/(const IntValue &other) const;
+				IntValue operator%(const IntValue &other) const;
+				IntValue operator&(const IntValue &other) const;
+				IntValue operator|(const IntValue &other) const;
+				IntValue operator^(const IntValue &other) const;
+
+				void print(std::ostream &os) const;
+		};
+
 		/// Type of the stored number.
 		Type type;
 
 		/// Value of the number if @c type of the number is @c INT.
-		Int intValue;
+		IntValue intValue;
 
 		/// Value of the number if @c type of the number is @c FLOAT.
 		Float floatValue;
@@ -55,11 +119,11 @@ class Number {
 
 		/// Minimal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c INT.
-		Int minIntLimit;
+		IntValue minIntLimit;
 
 		/// Maximal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c INT.
-		Int maxIntLimit;
+		IntValue maxIntLimit;
 
 		/// Minimal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c FLOAT.
@@ -75,12 +139,16 @@ class Number {
 		void integralPromotion();
 		void convertSignedToUnsigned();
 
+		Number(const IntValue &value, unsigned width, bool sign);
+
+		static Float intToFloat(const IntValue &n, bool isSigned);
 		static Number performTrunc(const Number &op1, const Number &op2, bool isMod);
 		static Number performBitOp(const Number &op1, const Number &op2, char mode);
 		static Number performShift(Number op1, Number op2, bool isLeft);
 
 	public:
 		Number(Int value, unsigned width, bool sign);
+		Number(long value, unsigned width, bool sign);
 		Number(Float value, unsigned width);
 
 		Number assign(const Number &n) const;
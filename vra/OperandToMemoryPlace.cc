@@ -21,6 +21,52 @@ using std::deque;
 map<OperandToMemoryPlace::UidVector, MemoryPlace*>
 	OperandToMemoryPlace::memoryPlaceMap;
 
+pthread_rwlock_t OperandToMemoryPlace::memoryPlaceMapLock =
+	PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+* @brief Returns the memory place with the given unique id. If there is no such
+*        memory place, it is created.
+*
+* The map is guarded by a read-write lock. Memory places that were used before
+* are found under the read lock, so threads do not wait for each other unless
+* a new memory place is created.
+*
+* @param[in] uidVector Unique id of the memory place.
+* @param[in] name Name of the memory place if it has to be created.
+* @param[in] artificial If the memory place was generated by the compiler.
+*
+* @return @c MemoryPlace instance with the unique id @a uidVector.
+*/
+MemoryPlace* OperandToMemoryPlace::getMemoryPlace(const UidVector &uidVector,
+												  const string &name,
+												  bool artificial)
+{
+	pthread_rwlock_rdlock(&OperandToMemoryPlace::memoryPlaceMapLock);
+	map<UidVector, MemoryPlace*>::const_iterator it =
+		OperandToMemoryPlace::memoryPlaceMap.find(uidVector);
+	MemoryPlace *var = (it != OperandToMemoryPlace::memoryPlaceMap.end()) ?
+		it->second : NULL;
+	pthread_rwlock_unlock(&OperandToMemoryPlace::memoryPlaceMapLock);
+
+	if (var != NULL) {
+		// This variable was used before. We return found record.
+		return var;
+	}
+
+	pthread_rwlock_wrlock(&OperandToMemoryPlace::memoryPlaceMapLock);
+	// Another thread could create the record in the meantime.
+	MemoryPlace *&record = OperandToMemoryPlace::memoryPlaceMap[uidVector];
+	if (NULL == record) {
+		// This variable is used for the first time.
+		record = new MemoryPlace(name, artificial);
+	}
+	var = record;
+	pthread_rwlock_unlock(&OperandToMemoryPlace::memoryPlaceMapLock);
+
+	return var;
+}
+
 /**
 * @brief Converts @c cl_operand to the instance of the @c MemoryPlace class. Used only
 *        for simple variables, elements of array, items of structures.
@@ -61,15 +107,7 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 
 	if (NULL == operand->accessor) {
 		// If the given cl_operand represents a simple variable.
-		if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-			// This variable is used for the first time.
-			MemoryPlace *var = new MemoryPlace(name, artificial);
-			OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-			return var;
-		} else {
-			// This variable was used before. We return found record.
-			return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-		}
+		return OperandToMemoryPlace::getMemoryPlace(uidVector, name, artificial);
 	} else if (CL_ACCESSOR_ITEM == (operand->accessor)->code ||
 			   CL_ACCESSOR_DEREF_ARRAY == (operand->accessor)->code) {
 		// If the given cl_operand represents an item of a structure or
@@ -92,15 +130,7 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 			actualAccessor = actualAccessor->next;
 		}
 
-		if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-			// This variable is used for the first time.
-			MemoryPlace *var = new MemoryPlace(name, artificial);
-			OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-			return var;
-		} else {
-			// This variable was used before. We return found record.
-			return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-		}
+		return OperandToMemoryPlace::getMemoryPlace(uidVector, name, artificial);
 	}
 
 	assert(!"Memory place cannot be created for the provided cl_operand.");
@@ -176,18 +206,7 @@ MemoryPlace* OperandToMemoryPlace::convert(const cl_operand *operand,
 		currentType = ((currentType->items)[index]).type;
 	}
 
-	if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-		// This variable is used for the first time.
-		MemoryPlace *var = new MemoryPlace(name, artificial);
-		OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-		return var;
-	} else {
-		// This variable was used before. We return found record.
-		return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-	}
-
-	assert(!"Memory places does not created for provided cl_operand.");
-	return new MemoryPlace("", true);
+	return OperandToMemoryPlace::getMemoryPlace(uidVector, name, artificial);
 }
 
 /**
@@ -195,5 +214,7 @@ MemoryPlace* OperandToMemoryPlace::convert(const cl_operand *operand,
 */
 void OperandToMemoryPlace::init()
 {
+	pthread_rwlock_wrlock(&OperandToMemoryPlace::memoryPlaceMapLock);
 	OperandToMemoryPlace::memoryPlaceMap.clear();
+	pthread_rwlock_unlock(&OperandToMemoryPlace::memoryPlaceMapLock);
 }
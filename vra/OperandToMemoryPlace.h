@@ -11,6 +11,8 @@
 #include <vector>
 #include <map>
 #include <deque>
+#include <string>
+#include <pthread.h>
 #include <cl/code_listener.h>
 #include <gmpxx.h>
 #include "MemoryPlace.h"
@@ -35,6 +37,13 @@ class OperandToMemoryPlace {
 		/// Map that for each @c UidVector stores corresponding @c MemoryPlace.
 		static std::map<UidVector, MemoryPlace*> memoryPlaceMap;
 
+		/// Guards @c memoryPlaceMap, functions are analysed by several threads.
+		static pthread_rwlock_t memoryPlaceMapLock;
+
+		static MemoryPlace* getMemoryPlace(const UidVector &uidVector,
+										   const std::string &name,
+										   bool artificial);
+
 		static MemoryPlace* convertSimpleOperand(const cl_operand *operand);
 
 	public:
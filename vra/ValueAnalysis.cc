@@ -13,6 +13,8 @@
 #include <cassert>
 #include <iterator>
 #include <algorithm>
+#include <set>
+#include <pthread.h>
 
 #include "Utility.h"
 #include "ValueAnalysis.h"
@@ -35,13 +37,7 @@ using std::deque;
 using std::sort;
 using std::pair;
 
-ValueAnalysis::BlockToTrimmedRangesMap ValueAnalysis::blockToTrimmedRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToInputRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToOutputRangesMap;
-ValueAnalysis::SchedulerQueue ValueAnalysis::todoQueue;
-ValueAnalysis::SchedulerSet ValueAnalysis::todoSet;
-ValueAnalysis::BlockToCounterMap ValueAnalysis::blockToCounterMap;
-LoopFinder::BlockToUpperLimit ValueAnalysis::tripCountOfBlockMap;
+ValueAnalysis::FncToDataMap ValueAnalysis::fncToDataMap;
 
 const unsigned ValueAnalysis::NumberOfPassesBeforeExpand = 1000;
 
@@ -60,14 +56,144 @@ bool sortBlockInfo(const ValueAnalysis::MemoryPlaceRangePair &f,
 }
 
 /**
-* @brief Schedules the block @a block. If @a block was scheduled earlier, it does
-*        nothing. Otherwise, it inserts @a block into schedulers.
+* @brief Returns the slot of the memory place @a mp. If @a mp has no slot yet,
+*        the next free slot is assigned to it.
 */
-void ValueAnalysis::scheduleBlock(const Block *block) {
-	if (todoSet.find(block) == todoSet.end()) {
+unsigned ValueAnalysis::MemoryPlaceIndex::getSlot(const MemoryPlace *mp)
+{
+	const unsigned id = mp->getId();
+	if (id >= idToSlot.size()) {
+		idToSlot.resize(id + 1, 0);
+	}
+
+	if (idToSlot[id] == 0) {
+		// The memory place is used for the first time.
+		places.push_back(mp);
+		idToSlot[id] = places.size();
+	}
+
+	return idToSlot[id] - 1;
+}
+
+/**
+* @brief Stores the slot of the memory place @a mp into @a slot. Returns @c true
+*        if @a mp has a slot, @c false otherwise.
+*/
+bool ValueAnalysis::MemoryPlaceIndex::findSlot(const MemoryPlace *mp,
+											   unsigned &slot) const
+{
+	const unsigned id = mp->getId();
+	if (id >= idToSlot.size() || idToSlot[id] == 0) {
+		return false;
+	}
+
+	slot = idToSlot[id] - 1;
+	return true;
+}
+
+/**
+* @brief Creates ranges for the memory places from @a index that are stored in
+*        @a map.
+*/
+ValueAnalysis::RangeVector::RangeVector(MemoryPlaceIndex *index,
+										const MemoryPlaceToRangeMap &map):
+	index(index)
+{
+	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &item, map) {
+		(*this)[item.first] = item.second;
+	}
+}
+
+/**
+* @brief Returns @c true if the range of the memory place @a mp is stored,
+*        @c false otherwise.
+*/
+bool ValueAnalysis::RangeVector::contains(const MemoryPlace *mp) const
+{
+	unsigned slot;
+	return index->findSlot(mp, slot) && has(slot);
+}
+
+/**
+* @brief Returns the range of the memory place @a mp. If it is not stored, an
+*        empty range is stored (in the same way as for @c std::map).
+*/
+Range& ValueAnalysis::RangeVector::operator[](const MemoryPlace *mp)
+{
+	return at(index->getSlot(mp));
+}
+
+/**
+* @brief Returns the range stored for @a slot. If it is not stored, an empty
+*        range is stored.
+*/
+Range& ValueAnalysis::RangeVector::at(unsigned slot)
+{
+	if (slot >= ranges.size()) {
+		ranges.resize(slot + 1);
+		known.resize(slot + 1, false);
+	}
+
+	known[slot] = true;
+	return ranges[slot];
+}
+
+/**
+* @brief Returns the stored ranges as a map.
+*/
+ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::RangeVector::toMap() const
+{
+	MemoryPlaceToRangeMap result;
+	for (unsigned slot = 0; slot != size(); ++slot) {
+		if (has(slot)) {
+			result[index->getMemoryPlace(slot)] = get(slot);
+		}
+	}
+
+	return result;
+}
+
+/**
+* @brief Returns @c true if the same ranges are stored for the same memory places
+*        in both vectors, @c false otherwise.
+*/
+bool ValueAnalysis::RangeVector::operator==(const RangeVector &other) const
+{
+	const unsigned common = std::min(size(), other.size());
+	for (unsigned slot = 0; slot != common; ++slot) {
+		if (has(slot) != other.has(slot)) {
+			return false;
+		} else if (has(slot) && get(slot) != other.get(slot)) {
+			return false;
+		}
+	}
+
+	// The remaining slots must be empty in the longer vector.
+	for (unsigned slot = common; slot < size(); ++slot) {
+		if (has(slot)) {
+			return false;
+		}
+	}
+
+	for (unsigned slot = common; slot < other.size(); ++slot) {
+		if (other.has(slot)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+* @brief Schedules the block with the number @a block. If the block was scheduled
+*        earlier, it does nothing. Otherwise, it inserts the block into the
+*        scheduler.
+*/
+void ValueAnalysis::scheduleBlock(FncData &data, unsigned block) {
+	if (!data.scheduled[block]) {
 		// If block was not scheduled, we schedule it.
-		todoQueue.push(block);
-		todoSet.insert(block);
+		data.todo.push(block);
+		data.scheduled[block] = true;
 	}
 }
 
@@ -78,7 +204,7 @@ void ValueAnalysis::scheduleBlock(const Block *block) {
 *        Otherwise, maximal possible range is returned.
 */
 Range ValueAnalysis::getRange(const struct cl_operand &src,
-							  MemoryPlaceToRangeMap &output,
+							  RangeVector &output,
 							  deque<int> indexes)
 {
 	Range srcRange;
@@ -90,7 +216,7 @@ Range ValueAnalysis::getRange(const struct cl_operand &src,
 	} else if (src.code == CL_OPERAND_VAR) {
 		// Right operand of the unary operation is a variable.
 		MemoryPlace *srcVar = OperandToMemoryPlace::convert(&src, indexes);
-		if (output.find(srcVar) != output.end()) {
+		if (output.contains(srcVar)) {
 			srcRange = output[srcVar];
 		} else {
 			// If we do not know what is in the variable, we set the maximal
@@ -116,7 +242,7 @@ Range ValueAnalysis::getRange(const struct cl_operand &src,
 */
 void ValueAnalysis::assignSimpleElement(const struct cl_operand &dst,
 										const struct cl_operand &src,
-										MemoryPlaceToRangeMap &output,
+										RangeVector &output,
 										deque<int> indDst,
 										deque<int> indSrc)
 {
@@ -189,7 +315,7 @@ const struct cl_type *ValueAnalysis::getType(const struct cl_operand &op)
 */
 void ValueAnalysis::assign(const struct cl_operand &dst,
 						   const struct cl_operand &src,
-						   MemoryPlaceToRangeMap &output)
+						   RangeVector &output)
 {
 	// Checks if left operand is valid.
 	assert(dst.code == CL_OPERAND_VAR);
@@ -220,48 +346,17 @@ void ValueAnalysis::assign(const struct cl_operand &dst,
 	}
 }
 
-/**
-* @brief If the given @a block is found as a key in the given @a inputMap
-*        then it returns the ranges associated with this key in @a inputMap.
-*        Otherwise, it returns an empty map.
-*/
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::getRanges(const Block* block,
-													const BlockToResultMap &inputMap)
-{
-	BlockToResultMap::const_iterator it = inputMap.find(block);
-	if (it != inputMap.end()) {
-		return it->second;
-	} else {
-		MemoryPlaceToRangeMap emptyMap;
-		return emptyMap;
-	}
-}
-
-/**
-* @brief If the given @a block is found as a key in @c blockToTrimmedRangesMap
-*        then it returns the output ranges that get off the given @a block.
-*        Otherwise, it returns an empty map.
-*/
-ValueAnalysis::TrimmedRangesMap ValueAnalysis::getTrimmedRanges(const Block* block)
-{
-	if (blockToTrimmedRangesMap.find(block) != blockToTrimmedRangesMap.end()) {
-		return blockToTrimmedRangesMap[block];
-	} else {
-		TrimmedRangesMap emptyMap;
-		return emptyMap;
-	}
-}
-
 /**
 * @brief Computes the partial input ranges for the given block @a current from
 *        the given output ranges of its predecessor stored in @a outs and from
 *        the given trimmed ranges of its predecessor stored in @a trimmed.
 */
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::computePartialInputRanges(
-	const CodeStorage::Block *current, const MemoryPlaceToRangeMap &outs,
+ValueAnalysis::RangeVector ValueAnalysis::computePartialInputRanges(
+	const CodeStorage::Block *current, const RangeVector &outs,
 	const TrimmedRangesMap &trimmed)
 {
-	MemoryPlaceToRangeMap result;
+	MemoryPlaceIndex *index = outs.getIndex();
+	RangeVector result(index);
 
 	BOOST_FOREACH(const TrimmedRangesMap::value_type &trim, trimmed) {
 		// Firstly, we choose all trimmed ranges that are valid for the given block
@@ -272,21 +367,20 @@ ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::computePartialInputRanges(
 			// If the trimmed range was computed for the current block, we set
 			// the variable for which the trimmed range was computed and store
 			// this trimmed range into the result map.
-			MemoryPlaceToRangeMap::const_iterator it = outs.find(key.varMp);
-			if (it != outs.end() && !(intersect(range, it->second)).empty()) {
-				result[key.varMp] = range;
+			unsigned slot;
+			if (index->findSlot(key.varMp, slot) && outs.has(slot) &&
+					!(intersect(range, outs.get(slot))).empty()) {
+				result.at(slot) = range;
 			}
 		}
 	}
 
-	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &out, outs) {
+	for (unsigned slot = 0; slot != outs.size(); ++slot) {
 		// Secondly, we choose the output ranges for variables that do not have
 		// trimmed ranges set.
-		const MemoryPlace *mp = out.first;
-		const Range &range = out.second;
-		if (result.find(mp) == result.end()) {
+		if (outs.has(slot) && !result.has(slot)) {
 			// If there was no trimming for this memory place, we just add it.
-			result[mp] = range;
+			result.at(slot) = outs.get(slot);
 		}
 	}
 
@@ -298,90 +392,84 @@ ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::computePartialInputRanges(
 *        trimmed ranges of predecessors' ranges. Trimmed ranges represents the ranges
 *        that are trimmed according to some condition in the block.
 */
-void ValueAnalysis::computeInputRanges(const CodeStorage::Block *current)
+void ValueAnalysis::computeInputRanges(FncData &data, unsigned current)
 {
-	// Gets the predecessor of the current block.
-	const TTargetList &preds = current->inbound();
-
-	// Stores the input ranges of the current block, output ranges or trimmed ranges
-	// of its predecessors.
-	MemoryPlaceToRangeMapVector outputOfPreds;
-	outputOfPreds.push_back(ValueAnalysis::getRanges(current, blockToInputRangesMap));
+	// Joins the input ranges of the current block with output ranges or trimmed
+	// ranges of its predecessors. It represents the input ranges into the
+	// currently processed block.
+	RangeVector inputToBlock = data.inputs[current];
 
-	BOOST_FOREACH(const TTargetList::value_type &pred, preds) {
+	BOOST_FOREACH(unsigned pred, data.preds[current]) {
 		// Get the output ranges of the predecessor.
-		MemoryPlaceToRangeMap out = ValueAnalysis::getRanges(pred,
-										blockToOutputRangesMap);
+		const RangeVector &out = data.outputs[pred];
 
-		if (blockToTrimmedRangesMap.find(pred) == blockToTrimmedRangesMap.end()) {
-			// If there are no trimmed ranges, we store the output ranges of
+		if (data.trimmed[pred].empty()) {
+			// If there are no trimmed ranges, we join the output ranges of
 			// predecessor.
-			outputOfPreds.push_back(out);
+			ValueAnalysis::join(inputToBlock, out);
 		} else {
 			// If there are trimmed ranges, we have to compute the result from
 			// predecessor's output and trimmed ranges.
-			TrimmedRangesMap trimmed = ValueAnalysis::getTrimmedRanges(pred);
-			MemoryPlaceToRangeMap result
-					= ValueAnalysis::computePartialInputRanges(current, out, trimmed);
-			outputOfPreds.push_back(result);
+			ValueAnalysis::join(inputToBlock,
+				ValueAnalysis::computePartialInputRanges(data.blocks[current],
+					out, data.trimmed[pred]));
 		}
 	}
 
-	// Joins the results of predecessors. It represents the input ranges into
-	// the currently processed block.
-	MemoryPlaceToRangeMap inputToBlock;
-	inputToBlock = ValueAnalysis::join(outputOfPreds);
+	if (data.wideningPoints[current] &&
+			data.passes[current] > ValueAnalysis::NumberOfPassesBeforeExpand &&
+			inputToBlock != data.inputs[current]) {
+		// If this loop head was analysed many times and still does not
+		// converge, we will help it a little. The input ranges are expanded,
+		// so the trimmed ranges computed in the loop head are expanded too.
+		inputToBlock = expandChangingRanges(data.inputs[current], inputToBlock);
+	}
 
 	// Assigns the input ranges to the currently processed block.
-	blockToInputRangesMap[current] = inputToBlock;
+	data.inputs[current] = inputToBlock;
 }
 
 /**
 * @brief Gets the ranges that are changing between @a oldResult and @a newResult
 *        and expands these for faster convergence. Then, these new ranges are
-*        stored for the output of the given @a block.
+*        returned. Integral ranges are expanded only in the direction in which
+*        they change.
 */
-void ValueAnalysis::expandChangingRanges(const Block* block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult)
+ValueAnalysis::RangeVector ValueAnalysis::expandChangingRanges(
+	const RangeVector &oldResult, const RangeVector &newResult)
 {
+	RangeVector result(newResult.getIndex());
+	for (unsigned slot = 0; slot != newResult.size(); ++slot) {
+		if (!newResult.has(slot)) {
+			continue;
+		}
 
-	MemoryPlaceToRangeMap result;
-	for (MemoryPlaceToRangeMap::const_iterator it = oldResult.begin();
-		 it != oldResult.end(); ++it) {
-
-		const MemoryPlace *key = it->first;
-
-		// Key must exists in both maps.
-		assert(newResult.find(key) != newResult.end());
-
-		Range oldRange = it->second;
-		MemoryPlaceToRangeMap::const_iterator jt = newResult.find(key);
-		Range newRange = jt->second;
-
-		if (oldRange == newRange) {
+		const Range &newRange = newResult.get(slot);
+		if (!oldResult.has(slot) || oldResult.get(slot) == newRange) {
 			// Ranges do not change.
-			result[key] = newRange;
+			result.at(slot) = newRange;
+		} else if (newRange.isIntegral()) {
+			// Ranges change after the last processing of the block. Only the
+			// bounds that change are expanded.
+			const Range &oldRange = oldResult.get(slot);
+			Range expanded = newRange.expand();
+			Number min = (newRange.getMin() < oldRange.getMin()) ?
+				expanded.getMin() : newRange.getMin();
+			Number max = (newRange.getMax() > oldRange.getMax()) ?
+				expanded.getMax() : newRange.getMax();
+			result.at(slot) = intersect(expanded, Range(Range::Interval(min, max)));
 		} else {
 			// Ranges change after the last processing of the block.
-			result[key] = newRange.expand();
+			result.at(slot) = newRange.expand();
 		}
 	}
 
-	// Firstly, I assumed that the size of oldResult and newResult must be same.
-	// However, this is not true. So, we have to add everything what is in
-	// newResult to result.
-	for (MemoryPlaceToRangeMap::const_iterator it = newResult.begin();
-		 it != newResult.end(); ++it) {
-
-		const MemoryPlace *key = it->first;
-		if (result.find(key) == result.end()) {
-			// If key is not in the result, we have to add it.
-			result[key] = it->second;
-		}
+	// Memory places are never removed from the ranges of the block.
+	for (unsigned slot = 0; slot != oldResult.size(); ++slot) {
+		assert(!oldResult.has(slot) || newResult.has(slot));
 	}
 
-	blockToOutputRangesMap[block] = result;
+	return result;
 }
 
 /**
@@ -396,81 +484,235 @@ bool ValueAnalysis::containOnlyGotoInsn(const Block *block)
 	return false;
 }
 
+/**
+* @brief Numbers the blocks of the given @a fnc that are reachable from its entry
+*        block in the reverse post-order and prepares @a data for the analysis.
+*
+* Targets of the edges that go backwards in this order are the loop heads. The
+* changing input ranges are expanded in them, unless all their incoming backward
+* edges leave blocks with the upper limit computed by @c LoopFinder. The analysis
+* of such loop stops after the given number of passes anyway.
+*/
+void ValueAnalysis::initFncData(const Fnc &fnc, FncData &data)
+{
+	// Depth-first search from the entry block, it stores the blocks in the
+	// post-order.
+	std::set<const Block *> visited;
+	vector<pair<const Block *, size_t> > stack;
+	const Block *entryBlock = fnc.cfg.entry();
+	visited.insert(entryBlock);
+	stack.push_back(std::make_pair(entryBlock, 0));
+	while (!stack.empty()) {
+		const Block *block = stack.back().first;
+		const TTargetList &succs = block->targets();
+		if (stack.back().second == succs.size()) {
+			data.blocks.push_back(block);
+			stack.pop_back();
+			continue;
+		}
+
+		const Block *succ = succs[stack.back().second++];
+		if (visited.insert(succ).second) {
+			stack.push_back(std::make_pair(succ, 0));
+		}
+	}
+	std::reverse(data.blocks.begin(), data.blocks.end());
+
+	const unsigned size = data.blocks.size();
+	for (unsigned i = 0; i != size; ++i) {
+		data.blockToNumber[data.blocks[i]] = i;
+	}
+
+	data.preds.resize(size);
+	data.succs.resize(size);
+	data.wideningPoints.resize(size, false);
+	data.upperLimits.resize(size);
+	for (unsigned i = 0; i != size; ++i) {
+		BOOST_FOREACH(const Block *succ, data.blocks[i]->targets()) {
+			data.succs[i].push_back(data.blockToNumber[succ]);
+		}
+
+		BOOST_FOREACH(const Block *pred, data.blocks[i]->inbound()) {
+			// Unreachable predecessors have no output ranges.
+			std::map<const Block *, unsigned>::const_iterator it =
+				data.blockToNumber.find(pred);
+			if (it != data.blockToNumber.end()) {
+				data.preds[i].push_back(it->second);
+			}
+		}
+
+		data.upperLimits[i] = LoopFinder::getUpperLimit(data.blocks[i]);
+	}
+
+	for (unsigned i = 0; i != size; ++i) {
+		BOOST_FOREACH(unsigned pred, data.preds[i]) {
+			if (pred >= i && data.upperLimits[pred] == 0) {
+				// Backward edge from the block without the upper limit.
+				data.wideningPoints[i] = true;
+			}
+		}
+	}
+
+	data.inputs.resize(size, RangeVector(&data.index));
+	data.outputs.resize(size, RangeVector(&data.index));
+	data.trimmed.resize(size);
+	data.passes.resize(size, 0);
+	data.tripCounts.resize(size, 0);
+	data.scheduled.resize(size, false);
+}
+
+/**
+* @brief Computes value-range analysis for all defined functions in @a stor.
+*
+* Functions are analysed independently of each other, so they are distributed
+* among @a threads threads (including the calling one). The data of all functions
+* are created before the threads start, so the threads only read the shared
+* results of @c LoopFinder and @c GlobAnalysis and each of them writes only the
+* data of the functions it analyses. The results do not depend on the number of
+* threads and they are printed by @c printRanges() in the order of the call graph.
+*/
+void ValueAnalysis::computeAnalysis(const Storage &stor, unsigned threads)
+{
+	FncQueue queue;
+	queue.next = 0;
+	BOOST_FOREACH(const Fnc* pFnc, stor.fncs) {
+		if (isDefined(*pFnc)) {
+			queue.fncs.push_back(std::make_pair(pFnc, &fncToDataMap[pFnc]));
+		}
+	}
+
+	// The largest functions go first, so no thread ends up with a large
+	// function at the end while the others are idle.
+	vector<pair<size_t, unsigned> > order;
+	for (unsigned i = 0; i < queue.fncs.size(); ++i) {
+		order.push_back(std::make_pair(queue.fncs[i].first->cfg.size(), i));
+	}
+	std::stable_sort(order.begin(), order.end(),
+		std::greater<pair<size_t, unsigned> >());
+	vector<pair<const Fnc*, FncData*> > fncs;
+	for (unsigned i = 0; i < order.size(); ++i) {
+		fncs.push_back(queue.fncs[order[i].second]);
+	}
+	queue.fncs.swap(fncs);
+
+	if (threads > queue.fncs.size()) {
+		threads = queue.fncs.size();
+	}
+
+	vector<pthread_t> workers;
+	for (unsigned i = 1; i < threads; ++i) {
+		pthread_t worker;
+		if (pthread_create(&worker, NULL, &ValueAnalysis::analyseFncs, &queue) != 0) {
+			// The remaining functions are analysed by the running threads.
+			break;
+		}
+		workers.push_back(worker);
+	}
+
+	ValueAnalysis::analyseFncs(&queue);
+
+	BOOST_FOREACH(pthread_t worker, workers) {
+		pthread_join(worker, NULL);
+	}
+}
+
+/**
+* @brief Analyses functions from the given @c FncQueue until there is none left.
+*
+* @param[in] queue Pointer to the @c FncQueue shared by all threads.
+*/
+void *ValueAnalysis::analyseFncs(void *queue)
+{
+	FncQueue &fncQueue = *static_cast<FncQueue *>(queue);
+
+	for (;;) {
+		const unsigned i = __sync_fetch_and_add(&fncQueue.next, 1);
+		if (i >= fncQueue.fncs.size()) {
+			return NULL;
+		}
+
+		ValueAnalysis::computeAnalysisForFnc(*fncQueue.fncs[i].first,
+			*fncQueue.fncs[i].second);
+	}
+}
+
 /**
 * @brief Computes value-range analysis for the given @a fnc.
 */
 void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
 {
-	const Block *entryBlock = fnc.cfg.entry();
+	ValueAnalysis::computeAnalysisForFnc(fnc, fncToDataMap[&fnc]);
+}
 
-	// Sets the ranges for global variables for the input of the entry block.
-	blockToInputRangesMap[entryBlock] = GlobAnalysis::getGlobVarMap();
+/**
+* @brief Computes value-range analysis for the given @a fnc and stores the result
+*        into its @a data.
+*
+* Blocks are processed in the reverse post-order, i.e. the scheduled block with
+* the lowest number goes first. So, the block is processed after all its scheduled
+* predecessors (except the ones in the loop) and the inner loops are stabilized
+* before their outer loops continue.
+*/
+void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc, FncData &data)
+{
+	ValueAnalysis::initFncData(fnc, data);
 
-	todoQueue.push(entryBlock);
-	todoSet.insert(entryBlock);
+	// Sets the ranges for global variables for the input of the entry block.
+	const unsigned entryBlock = 0;
+	data.inputs[entryBlock] = RangeVector(&data.index,
+		GlobAnalysis::getGlobVarMap());
 
-	while (!todoQueue.empty()) {
-		const Block *block = todoQueue.front();
-		todoQueue.pop();
-		todoSet.erase(block);
+	ValueAnalysis::scheduleBlock(data, entryBlock);
 
-		MemoryPlaceToRangeMap oldResult = ValueAnalysis::getRanges(block,
-			blockToOutputRangesMap);
+	while (!data.todo.empty()) {
+		const unsigned block = data.todo.top();
+		data.todo.pop();
+		data.scheduled[block] = false;
 
-		unsigned long tripCount = LoopFinder::getUpperLimit(block);
-		if ((tripCount != 0) &&
-			(tripCount == ValueAnalysis::tripCountOfBlockMap[block]) ) {
+		unsigned long tripCount = data.upperLimits[block];
+		if ((tripCount != 0) && (tripCount == data.tripCounts[block])) {
 			// This block was processed enough times.
-			ValueAnalysis::tripCountOfBlockMap[block] = 0;
+			data.tripCounts[block] = 0;
 			continue;
 		}
 
-		ValueAnalysis::computeAnalysisForBlock(block);
-		++ValueAnalysis::tripCountOfBlockMap[block];
-		MemoryPlaceToRangeMap newResult = ValueAnalysis::getRanges(block,
-			blockToOutputRangesMap);
+		const RangeVector oldResult = data.outputs[block];
 
-		if (newResult != oldResult) {
-			// If this block was analysed many times and still does
-			// not converge, we will help it a little.
-			if (blockToCounterMap[block] > ValueAnalysis::NumberOfPassesBeforeExpand) {
-				expandChangingRanges(block, oldResult, newResult);
-			}
-		}
+		ValueAnalysis::computeAnalysisForBlock(data, block);
+		++data.tripCounts[block];
 
-		newResult = ValueAnalysis::getRanges(block, blockToOutputRangesMap);
-		if ((newResult != oldResult) || (ValueAnalysis::containOnlyGotoInsn(block))) {
-			// Gets the successors of the processed block.
-			const TTargetList &succs = block->targets();
-			BOOST_FOREACH(const TTargetList::value_type &succ, succs) {
-				ValueAnalysis::scheduleBlock(succ);
+		if ((data.outputs[block] != oldResult) ||
+				(ValueAnalysis::containOnlyGotoInsn(data.blocks[block]))) {
+			// Schedules the successors of the processed block.
+			BOOST_FOREACH(unsigned succ, data.succs[block]) {
+				ValueAnalysis::scheduleBlock(data, succ);
 			}
 		}
 	}
 }
 
 /**
-* @brief Computes value-range analysis for the given @a block.
+* @brief Computes value-range analysis for the block with the number @a block.
 */
-void ValueAnalysis::computeAnalysisForBlock(const Block *block)
+void ValueAnalysis::computeAnalysisForBlock(FncData &data, unsigned block)
 {
-	computeInputRanges(block);
+	computeInputRanges(data, block);
 
-	MemoryPlaceToRangeMap outputFromBlock;
-	outputFromBlock = ValueAnalysis::getRanges(block, blockToInputRangesMap);
+	RangeVector outputFromBlock = data.inputs[block];
 
 	// Starts to analyze the given block.
 	const Insn *prevInsn = NULL;
-	BOOST_FOREACH(const Insn *insn, *block) {
-		ValueAnalysis::computeAnalysisForInsn(insn, prevInsn, outputFromBlock);
+	BOOST_FOREACH(const Insn *insn, *data.blocks[block]) {
+		ValueAnalysis::computeAnalysisForInsn(insn, prevInsn, outputFromBlock,
+			data.trimmed[block]);
 		prevInsn = insn;
 	}
 
 	// Assigns the output ranges to the currently processed block.
-	blockToOutputRangesMap[block] = outputFromBlock;
+	data.outputs[block] = outputFromBlock;
 
 	// Increments counter.
-	++blockToCounterMap[block];
+	++data.passes[block];
 }
 
 /**
@@ -478,7 +720,7 @@ void ValueAnalysis::computeAnalysisForBlock(const Block *block)
 *        call instruction. Results are stored in @a output.
 */
 void ValueAnalysis::computeAnalysisForCall(const Insn* insn,
-	MemoryPlaceToRangeMap &output)
+	RangeVector &output)
 {
 	const TOperandList &opList = insn->operands;
 	const struct cl_operand &ret = opList[0];   // [0] - destination
@@ -494,10 +736,11 @@ void ValueAnalysis::computeAnalysisForCall(const Insn* insn,
 
 /**
 * @brief Computes value-range analysis for the given @a insn and computed result
-*        joins to @a output.
+*        joins to @a output. Trimmed ranges of the block are stored in @a trimmed.
 */
 void ValueAnalysis::computeAnalysisForInsn(const Insn *insn, const Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output)
+										   RangeVector &output,
+										   TrimmedRangesMap &trimmed)
 {
 	const enum cl_insn_e code = insn->code;
 
@@ -512,7 +755,7 @@ void ValueAnalysis::computeAnalysisForInsn(const Insn *insn, const Insn *prevIns
 
 		case CL_INSN_COND:
 			// Condition.
-			ValueAnalysis::computeAnalysisForCond(insn, prevInsn, output);
+			ValueAnalysis::computeAnalysisForCond(insn, prevInsn, output, trimmed);
 			break;
 
 		case CL_INSN_RET:
@@ -608,10 +851,12 @@ bool ValueAnalysis::evaluateCond(const Range &r1, const Range &r2,
 /**
 * @brief Computes value-range analysis for the condition instruction @a insn,
 *        where @a prevInsn is previous instruction to the @a insn instruction.
-*        This function is responsible for computing trimmed ranges.
+*        This function is responsible for computing trimmed ranges, they are
+*        stored in @a trimmed.
 */
 void ValueAnalysis::computeAnalysisForCond(const Insn *insn, const Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output)
+										   RangeVector &output,
+										   TrimmedRangesMap &trimmed)
 {
 	if (prevInsn == NULL) {
 		// If we do not have previous instruction, we cannot compute trimmed ranges.
@@ -776,20 +1021,17 @@ void ValueAnalysis::computeAnalysisForCond(const Insn *insn, const Insn *prevIns
 		// We store the result for the first operand of the condition.
 		struct TrimmedKey key1(condVar, thenTarget, srcVar1);
 		struct TrimmedKey key2(condVar, elseTarget, srcVar1);
-		TrimmedRangesMap trimmedRangesMap;
-		trimmedRangesMap[key1] = srcRange1True;
-		trimmedRangesMap[key2] = srcRange1False;
-		blockToTrimmedRangesMap[insn->bb] = trimmedRangesMap;
+		trimmed.clear();
+		trimmed[key1] = srcRange1True;
+		trimmed[key2] = srcRange1False;
 	}
 
 	if (CL_OPERAND_VAR == src2.code) {
 		// We store the result for the second operand of the condition.
 		struct TrimmedKey key1(condVar, thenTarget, srcVar2);
 		struct TrimmedKey key2(condVar, elseTarget, srcVar2);
-		TrimmedRangesMap trimmedRangesMap = blockToTrimmedRangesMap[insn->bb];
-		trimmedRangesMap[key1] = srcRange2True;
-		trimmedRangesMap[key2] = srcRange2False;
-		blockToTrimmedRangesMap[insn->bb] = trimmedRangesMap;
+		trimmed[key1] = srcRange2True;
+		trimmed[key2] = srcRange2False;
 	}
 }
 
@@ -798,7 +1040,7 @@ void ValueAnalysis::computeAnalysisForCond(const Insn *insn, const Insn *prevIns
 *        an unary operation and computed result joins to @a output.
 */
 void ValueAnalysis::computeAnalysisForUnop(const Insn *insn,
-				    					   MemoryPlaceToRangeMap &output)
+				    					   RangeVector &output)
 {
 	// There are two operands for unary operations.
 	const TOperandList &opList = insn->operands;
@@ -873,7 +1115,7 @@ void ValueAnalysis::computeAnalysisForUnop(const Insn *insn,
 *        a binary operation and computed result joins to @a output.
 */
 void ValueAnalysis::computeAnalysisForBinop(const Insn *insn,
-	 										MemoryPlaceToRangeMap &output)
+	 										RangeVector &output)
 {
 	// There are three operands for binary operation.
 	const TOperandList &opList = insn->operands;
@@ -1050,6 +1292,9 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 		if (!isDefined(fnc))
 			continue;
 
+		// Blocks that were not analysed have no ranges.
+		FncToDataMap::const_iterator fncData = fncToDataMap.find(pFnc);
+
 		string delimeter(10, '-');
 		os << delimeter << " Function " << nameOf(fnc) << "() ";
 		os << delimeter << endl;
@@ -1069,8 +1314,21 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 			os << firstLine << " to ";
 			os << lastLine << ":" << endl;
 
+			unsigned number = 0;
+			bool analysed = false;
+			if (fncData != fncToDataMap.end()) {
+				const FncData &data = fncData->second;
+				std::map<const Block *, unsigned>::const_iterator it =
+					data.blockToNumber.find(pBlock);
+				analysed = (it != data.blockToNumber.end());
+				if (analysed)
+					number = it->second;
+			}
+
 			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfo = blockToInputRangesMap[pBlock];
+			MemoryPlaceToRangeMap blockInfo;
+			if (analysed)
+				blockInfo = fncData->second.inputs[number].toMap();
 			vector<MemoryPlaceRangePair> sortedBlockInfo(
 				blockInfo.begin(), blockInfo.end());
 
@@ -1091,7 +1349,9 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 			os << "Block " << block.name() << "[OUT]:" << endl;
 
 			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfoOut = blockToOutputRangesMap[pBlock];
+			MemoryPlaceToRangeMap blockInfoOut;
+			if (analysed)
+				blockInfoOut = fncData->second.outputs[number].toMap();
 			vector<MemoryPlaceRangePair> sortedBlockInfoOut(
 				blockInfoOut.begin(), blockInfoOut.end());
 
@@ -1115,32 +1375,23 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 /**
 * @brief Joins data that was gained from the analysis of several blocks.
 *
-* @param[in] vec Data gained from the analysis of several blocks.
+* @param[in,out] result Data gained from the analysis of several blocks, @a other
+*                       is united into it.
+* @param[in] other Data gained from the analysis of another block.
 *
-* @return United data from @a vec.
-*
-* Value-range analysis of every block is represented by @c MemoryPlaceToRangeMap
+* Value-range analysis of every block is represented by @c RangeVector
 * that contains all memory places and corresponding ranges for them. During
 * value-range analysis it is necessary to join data of different blocks
 * together. For example, join data of all predecessor blocks that will be
 * used as an input to the next block.
 */
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::join(const
-				             MemoryPlaceToRangeMapVector &vec)
+void ValueAnalysis::join(RangeVector &result, const RangeVector &other)
 {
-	MemoryPlaceToRangeMap result;
-	if (vec.empty())
-		return result;
-
-	result = vec[0];
-	for (MemoryPlaceToRangeMap::size_type i = 1; i != vec.size(); ++i) {
-		// Iterates over all data that was got from several blocks.
-		BOOST_FOREACH(MemoryPlaceToRangeMap::value_type item, vec[i]) {
-			// Iterates over all memory places.
-			result[item.first] = unite(result[item.first], item.second);
+	for (unsigned slot = 0; slot != other.size(); ++slot) {
+		// Iterates over all memory places.
+		if (other.has(slot)) {
+			Range &range = result.at(slot);
+			range = unite(range, other.get(slot));
 		}
 	}
-
-	return result;
 }
-
@@ -17,6 +17,7 @@
 #include <vector>
 #include <set>
 #include <queue>
+#include <functional>
 
 #include "Range.h"
 #include "MemoryPlace.h"
@@ -42,10 +43,6 @@ class ValueAnalysis {
 		/// Just for assurance that nobody will try to use it.
 		ValueAnalysis() { }
 
-		/// Stores maximal number of passes through the block or zero if we do
-		/// not know.
-		static LoopFinder::BlockToUpperLimit tripCountOfBlockMap;
-
 		/// Type for representing key into map that stores trimmed ranges.
 		struct TrimmedKey {
 			/// Pointer to the memory place for the condition variable.
@@ -83,98 +80,219 @@ class ValueAnalysis {
 		/// Type for trimmed ranges stored for one block.
 		typedef std::map<TrimmedKey, Range> TrimmedRangesMap;
 
-		/// Type for trimmed ranges stored for every block in the analyzed program.
-		typedef std::map<const CodeStorage::Block*, TrimmedRangesMap>
-			BlockToTrimmedRangesMap;
+		/**
+		* @brief Dense numbering of memory places used in one function.
+		*
+		* Memory places are numbered from zero in the order in which the analysis
+		* of the function meets them. These numbers (slots) are used as indexes
+		* into @c RangeVector.
+		*/
+		class MemoryPlaceIndex {
+			public:
+				unsigned getSlot(const MemoryPlace *mp);
+
+				bool findSlot(const MemoryPlace *mp, unsigned &slot) const;
+
+				/// Returns the memory place with the given @a slot.
+				const MemoryPlace *getMemoryPlace(unsigned slot) const
+					{ return places[slot]; }
+
+				/// Returns the number of numbered memory places.
+				unsigned size() const { return places.size(); }
+
+			private:
+				/// For each memory place id, stores its slot increased by one,
+				/// zero if the memory place has no slot.
+				std::vector<unsigned> idToSlot;
+
+				/// For each slot, stores the corresponding memory place.
+				std::vector<const MemoryPlace*> places;
+		};
+
+		/**
+		* @brief Ranges of memory places in one block.
+		*
+		* The range of a memory place is stored on the position given by the slot
+		* of the memory place in the @c MemoryPlaceIndex of the analysed function.
+		* It replaces @c MemoryPlaceToRangeMap during the analysis, so only the
+		* access through the slots is added to the interface of the map.
+		*/
+		class RangeVector {
+			public:
+				/// Creates empty ranges for the memory places from @a index.
+				explicit RangeVector(MemoryPlaceIndex *index = NULL):
+					index(index) {}
+
+				RangeVector(MemoryPlaceIndex *index,
+							const MemoryPlaceToRangeMap &map);
+
+				bool contains(const MemoryPlace *mp) const;
+
+				Range& operator[](const MemoryPlace *mp);
+
+				/// Returns the number of slots, it is an upper bound of the slots
+				/// of stored ranges.
+				unsigned size() const { return ranges.size(); }
+
+				/// Returns @c true if the range is stored for @a slot.
+				bool has(unsigned slot) const
+					{ return slot < known.size() && known[slot]; }
+
+				/// Returns the range stored for @a slot.
+				const Range& get(unsigned slot) const { return ranges[slot]; }
+
+				Range& at(unsigned slot);
+
+				/// Returns the numbering of memory places.
+				MemoryPlaceIndex *getIndex() const { return index; }
+
+				MemoryPlaceToRangeMap toMap() const;
+
+				bool operator==(const RangeVector &other) const;
+
+				bool operator!=(const RangeVector &other) const
+					{ return !(*this == other); }
+
+			private:
+				/// Numbering of memory places.
+				MemoryPlaceIndex *index;
+
+				/// For each slot, stores the range.
+				std::vector<Range> ranges;
+
+				/// For each slot, stores @c true if the range is stored.
+				std::vector<bool> known;
+		};
 
 		/// Type of data stored for several blocks.
-		typedef std::vector<MemoryPlaceToRangeMap> MemoryPlaceToRangeMapVector;
+		typedef std::vector<RangeVector> RangeVectorVector;
 
-		/// Type of data stored for the whole analyzed program.
-		typedef std::map<const CodeStorage::Block*, MemoryPlaceToRangeMap>
-			BlockToResultMap;
+		/**
+		* @brief Data of the analysis of one function.
+		*
+		* Blocks that are reachable from the entry block are numbered from zero
+		* in the reverse post-order, everything is stored in vectors indexed by
+		* these numbers.
+		*/
+		struct FncData {
+			/// Numbering of memory places.
+			MemoryPlaceIndex index;
+
+			/// Reachable blocks in the reverse post-order.
+			std::vector<const CodeStorage::Block *> blocks;
+
+			/// Mapping block to its number.
+			std::map<const CodeStorage::Block *, unsigned> blockToNumber;
+
+			/// Numbers of predecessors of each block.
+			std::vector<std::vector<unsigned> > preds;
+
+			/// Numbers of successors of each block.
+			std::vector<std::vector<unsigned> > succs;
+
+			/// Loop heads where the changing input ranges are expanded.
+			std::vector<bool> wideningPoints;
 
-		/// Type for representing scheduler.
-		typedef std::queue<const CodeStorage::Block *> SchedulerQueue;
+			/// Maximal number of passes through each block, see @c LoopFinder.
+			std::vector<unsigned long> upperLimits;
 
-		/// Type for representing scheduler.
-		typedef std::set<const CodeStorage::Block *> SchedulerSet;
+			/// Input ranges of each block.
+			RangeVectorVector inputs;
 
-		/// Type for representing block counter.
-		typedef std::map<const CodeStorage::Block *, unsigned> BlockToCounterMap;
+			/// Output ranges of each block.
+			RangeVectorVector outputs;
 
-		/// Mapping block to the trimmed ranges of this block.
-		static BlockToTrimmedRangesMap blockToTrimmedRangesMap;
+			/// Trimmed ranges of each block.
+			std::vector<TrimmedRangesMap> trimmed;
 
-		/// Mapping block to the input ranges of this block.
-		static BlockToResultMap blockToInputRangesMap;
+			/// How many times was each block executed.
+			std::vector<unsigned> passes;
 
-		/// Mapping block to the output ranges of this block.
-		static BlockToResultMap blockToOutputRangesMap;
+			/// How many times was each block executed since the last reaching
+			/// of its upper limit.
+			std::vector<unsigned long> tripCounts;
 
-		/// Block scheduler.
-		static SchedulerQueue todoQueue;
+			/// Blocks that are scheduled.
+			std::vector<bool> scheduled;
 
-		/// Block scheduler.
-		static SchedulerSet todoSet;
+			/// Block scheduler, the block with the lowest number goes first.
+			std::priority_queue<unsigned, std::vector<unsigned>,
+				std::greater<unsigned> > todo;
+		};
+
+		/// Type of data stored for the whole analyzed program.
+		typedef std::map<const CodeStorage::Fnc*, FncData> FncToDataMap;
+
+		/// Data of all analysed functions.
+		static FncToDataMap fncToDataMap;
 
-		/// Specifies how many times the block is executed before the expansion
-		/// of changing ranges will be performed.
+		/// Functions analysed by the threads of @c computeAnalysis(). Each
+		/// thread takes the next function until there is none left.
+		struct FncQueue {
+			/// Functions together with their data, the largest ones first.
+			std::vector<std::pair<const CodeStorage::Fnc*, FncData*> > fncs;
+
+			/// Index of the next function to be analysed.
+			unsigned next;
+		};
+
+		/// Specifies how many times the loop head is executed before the
+		/// expansion of changing ranges will be performed.
 		static const unsigned NumberOfPassesBeforeExpand;
 
-		/// Stores how many times was the block executed.
-		static BlockToCounterMap blockToCounterMap;
+		static void *analyseFncs(void *queue);
 
-		static void scheduleBlock(const CodeStorage::Block *block);
+		static void computeAnalysisForFnc(const CodeStorage::Fnc &fnc,
+			FncData &data);
 
-		static MemoryPlaceToRangeMap getRanges(const CodeStorage::Block* block,
-											   const BlockToResultMap &inputMap);
+		static void initFncData(const CodeStorage::Fnc &fnc, FncData &data);
 
-		static TrimmedRangesMap getTrimmedRanges(const CodeStorage::Block* block);
+		static void scheduleBlock(FncData &data, unsigned block);
 
-		static MemoryPlaceToRangeMap join(const MemoryPlaceToRangeMapVector &vec);
+		static void join(RangeVector &result, const RangeVector &other);
 
-		static MemoryPlaceToRangeMap computePartialInputRanges(
+		static RangeVector computePartialInputRanges(
 											const CodeStorage::Block *current,
-											const MemoryPlaceToRangeMap &out,
+											const RangeVector &out,
 											const TrimmedRangesMap &trimmed);
 
-		static void computeInputRanges(const CodeStorage::Block *current);
+		static void computeInputRanges(FncData &data, unsigned current);
 
-		static void expandChangingRanges(const CodeStorage::Block *block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult);
+		static RangeVector expandChangingRanges(const RangeVector &oldResult,
+												const RangeVector &newResult);
 
-		static void computeAnalysisForBlock(const CodeStorage::Block *block);
+		static void computeAnalysisForBlock(FncData &data, unsigned block);
 
 		static void computeAnalysisForInsn(const CodeStorage::Insn *insn,
 										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+										   RangeVector &output,
+										   TrimmedRangesMap &trimmed);
 
 		static void computeAnalysisForCond(const CodeStorage::Insn *insn,
 										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+										   RangeVector &output,
+										   TrimmedRangesMap &trimmed);
 
 		static void computeAnalysisForUnop(const CodeStorage::Insn *insn,
-										   MemoryPlaceToRangeMap &output);
+										   RangeVector &output);
 
 		static void computeAnalysisForBinop(const CodeStorage::Insn *insn,
-										    MemoryPlaceToRangeMap &output);
+										    RangeVector &output);
 
 		static void computeAnalysisForCall(const CodeStorage::Insn* insn,
-										   MemoryPlaceToRangeMap &output);
+										   RangeVector &output);
 
 		static Range getRange(const struct cl_operand &src,
-							  MemoryPlaceToRangeMap &output,
+							  RangeVector &output,
 							  std::deque<int> indexes = std::deque<int>());
 
 		static void assign(const struct cl_operand &dst, const struct cl_operand &src,
-						   MemoryPlaceToRangeMap &output);
+						   RangeVector &output);
 
 		static void assignStructure(const struct cl_type *type,
 									const struct cl_operand &dst,
 									const struct cl_operand &src,
-				    				MemoryPlaceToRangeMap &output,
+				    				RangeVector &output,
 									std::deque<int> &indexes);
 
 		static void generateIndexes(const struct cl_type *type,
@@ -183,7 +301,7 @@ class ValueAnalysis {
 
 		static void assignSimpleElement(const struct cl_operand &dst,
 								 		const struct cl_operand &src,
-				 				 		MemoryPlaceToRangeMap &output,
+				 				 		RangeVector &output,
 								 		std::deque<int> indDst = std::deque<int>(),
 										std::deque<int> indSrc = std::deque<int>());
 
@@ -200,6 +318,9 @@ class ValueAnalysis {
 										 const CodeStorage::Storage &stor);
 
 		static void computeAnalysisForFnc(const CodeStorage::Fnc &fnc);
+
+		static void computeAnalysis(const CodeStorage::Storage &stor,
+									unsigned threads);
 };
 
 #endif
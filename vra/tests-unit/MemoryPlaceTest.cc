@@ -138,6 +138,20 @@ RepresentsElementOfArrayOfStructureItemWorksCorrectly)
 	EXPECT_FALSE(m.representsElementOfArray());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// unique number of a memory place
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(MemoryPlaceTest,
+MemoryPlacesAreNumberedInOrderOfCreation)
+{
+	MemoryPlace m1("var", false);
+	MemoryPlace m2("var", false);
+	MemoryPlace m3("struct.var", true);
+	EXPECT_EQ(m1.getId() + 1, m2.getId());
+	EXPECT_EQ(m2.getId() + 1, m3.getId());
+}
+
 
 int main(int argc, char *argv[])
 {
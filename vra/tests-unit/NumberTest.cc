@@ -642,6 +642,15 @@ GetIntOfIntegralNumberWorksCorrectly)
 	EXPECT_EQ(mpz_class(vmin<int>()), (I<int>(vmin<int>())).getInt());
 }
 
+TEST_F(NumberTest,
+GetIntOfUnsignedLongAboveLongMaxWorksCorrectly)
+{
+	EXPECT_EQ(mpz_class(vmax<unsigned long>()),
+		(I<unsigned long>(vmax<unsigned long>())).getInt());
+	EXPECT_EQ(mpz_class(vmax<long>() + 1UL),
+		(I<unsigned long>(vmax<long>() + 1UL)).getInt());
+}
+
 TEST_F(NumberTest,
 GetIntOfFloatingPointNumberWorksCorrectly)
 {
@@ -1065,6 +1074,93 @@ LongDoubleOpLongDoubleResultsIntoLongDouble)
 		(F<long double>(0) + F<long double>(0)).getMax());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// fitting into the bit width
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(NumberTest,
+SignedIntOutOfRangeKeepsOnlyItsLowerBits)
+{
+	EXPECT_EQ(I<signed char>(vmin<signed char>()),
+		N(0x180L, sizeof(signed char), true));
+	EXPECT_EQ(I<signed char>(vmax<signed char>()),
+		N(-0x81L, sizeof(signed char), true));
+	EXPECT_EQ(I<signed char>(-1), N(0x7FFFL, sizeof(signed char), true));
+
+	EXPECT_EQ(I<short>(vmin<short>()), N(0x18000L, sizeof(short), true));
+	EXPECT_EQ(I<short>(vmax<short>()), N(-0x8001L, sizeof(short), true));
+	EXPECT_EQ(I<short>(-1), N(0x7FFFFFFFL, sizeof(short), true));
+
+	EXPECT_EQ(I<int>(vmin<int>()), N(0x180000000L, sizeof(int), true));
+	EXPECT_EQ(I<int>(vmax<int>()), N(-0x80000001L, sizeof(int), true));
+	EXPECT_EQ(I<int>(-1), N(0x7FFFFFFFFFFFL, sizeof(int), true));
+
+	EXPECT_EQ(I<long>(vmin<long>()), N(vmin<long>(), sizeof(long), true));
+	EXPECT_EQ(I<long>(vmax<long>()), N(vmax<long>(), sizeof(long), true));
+	EXPECT_EQ(I<long>(-1), N(-1L, sizeof(long), true));
+}
+
+TEST_F(NumberTest,
+UnsignedIntOutOfRangeKeepsOnlyItsLowerBits)
+{
+	EXPECT_EQ(I<unsigned char>(vmax<unsigned char>()),
+		N(-1L, sizeof(unsigned char), false));
+	EXPECT_EQ(I<unsigned char>(0), N(0x100L, sizeof(unsigned char), false));
+	EXPECT_EQ(I<unsigned char>(0x80), N(-0x80L, sizeof(unsigned char), false));
+
+	EXPECT_EQ(I<unsigned short>(vmax<unsigned short>()),
+		N(-1L, sizeof(unsigned short), false));
+	EXPECT_EQ(I<unsigned short>(1), N(0x10001L, sizeof(unsigned short), false));
+	EXPECT_EQ(I<unsigned short>(0x8000),
+		N(-0x8000L, sizeof(unsigned short), false));
+
+	EXPECT_EQ(I<unsigned>(vmax<unsigned>()), N(-1L, sizeof(unsigned), false));
+	EXPECT_EQ(I<unsigned>(1), N(0x100000001L, sizeof(unsigned), false));
+	EXPECT_EQ(I<unsigned>(0x80000000U),
+		N(-0x80000000L, sizeof(unsigned), false));
+
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>()),
+		N(-1L, sizeof(unsigned long), false));
+	EXPECT_EQ(I<unsigned long>(vmax<long>() + 1UL),
+		N(vmin<long>(), sizeof(unsigned long), false));
+}
+
+TEST_F(NumberTest,
+AssignOfIntIntoNarrowerIntKeepsOnlyItsLowerBits)
+{
+	EXPECT_EQ(I<signed char>(-1), I<signed char>(0).assign(I<long>(-1)));
+	EXPECT_EQ(I<signed char>(0x12), I<signed char>(0).assign(I<long>(0x3412)));
+	EXPECT_EQ(I<unsigned char>(vmax<unsigned char>()),
+		I<unsigned char>(0).assign(I<long>(-1)));
+	EXPECT_EQ(I<unsigned char>(vmax<unsigned char>()),
+		I<unsigned char>(0).assign(I<unsigned long>(vmax<unsigned long>())));
+
+	EXPECT_EQ(I<short>(0x5678), I<short>(0).assign(I<long>(0x12345678)));
+	EXPECT_EQ(I<unsigned short>(vmax<unsigned short>()),
+		I<unsigned short>(0).assign(I<unsigned long>(vmax<unsigned long>())));
+
+	EXPECT_EQ(I<int>(-1), I<int>(0).assign(I<unsigned long>(vmax<unsigned long>())));
+	EXPECT_EQ(I<unsigned>(vmax<unsigned>()),
+		I<unsigned>(0).assign(I<unsigned long>(vmax<unsigned long>())));
+
+	EXPECT_EQ(I<long>(-1), I<long>(0).assign(I<unsigned long>(vmax<unsigned long>())));
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>()),
+		I<unsigned long>(0).assign(I<long>(-1)));
+}
+
+TEST_F(NumberTest,
+SignedIntConvertedToUnsignedIntKeepsOnlyItsLowerBits)
+{
+	// The signed operand is converted to the unsigned type by the extension.
+	EXPECT_EQ(I<unsigned>(vmax<unsigned>() - 1), I<unsigned>(5) + I<int>(-7));
+	EXPECT_EQ(I<unsigned>(0x80000000U), I<unsigned>(0) + I<int>(vmin<int>()));
+
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>() - 1),
+		I<unsigned long>(5) + I<long>(-7));
+	EXPECT_EQ(I<unsigned long>(vmax<long>() + 1UL),
+		I<unsigned long>(0) + I<long>(vmin<long>()));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // - (unary)
 ////////////////////////////////////////////////////////////////////////////////
@@ -1116,6 +1212,24 @@ NegatedMinimalSignedIntIsStillMinimalSignedInt)
 	EXPECT_EQ(I(vmin<long>()), -I<long>(vmin<long>()));
 }
 
+TEST_F(NumberTest,
+NegatedMinimalSignedLongCanBeUsedInFurtherComputation)
+{
+	// -LONG_MIN does not fit into long, it is fitted back into the bit width.
+	EXPECT_EQ(I<long>(vmin<long>() + 1), -I<long>(vmin<long>()) + I<long>(1));
+	EXPECT_EQ(I<long>(vmin<long>()), -(-I<long>(vmin<long>())));
+}
+
+TEST_F(NumberTest,
+NegatedUnsignedLongAboveLongMaxGetsCorrectlyNegated)
+{
+	EXPECT_EQ(I<unsigned long>(1), -I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_EQ(I<unsigned long>(vmax<long>() + 1UL),
+		-I<unsigned long>(vmax<long>() + 1UL));
+	EXPECT_EQ(I<unsigned long>(vmax<long>()),
+		-I<unsigned long>(vmax<long>() + 2UL));
+}
+
 TEST_F(NumberTest,
 NegatedFloatGetsCorrectlyNegated)
 {
@@ -1180,6 +1294,17 @@ UnsignedIntOneIsLessThanNegativeSignedIntOne)
 	EXPECT_LT(I<unsigned int>(1), I<int>(-1));
 }
 
+TEST_F(NumberTest,
+LesserUnsignedLongIsLessThanGreaterUnsignedLongAboveLongMax)
+{
+	EXPECT_LT(I<unsigned long>(vmax<long>()), I<unsigned long>(vmax<long>() + 1UL));
+	EXPECT_LT(I<unsigned long>(vmax<long>() + 1UL),
+		I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_LT(I<long>(vmax<long>()), I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_FALSE(I<unsigned long>(vmax<unsigned long>()) <
+		I<unsigned long>(vmax<unsigned long>()));
+}
+
 TEST_F(NumberTest,
 LesserFloatIsLessThanGreaterFloat)
 {
@@ -1383,6 +1508,34 @@ AdditionOfTwoUnsignedIntsWorksCorrectlyWhenOverflowOccurs)
 		I<unsigned>(vmax<unsigned>()) + I<unsigned>(vmax<unsigned>()));
 }
 
+TEST_F(NumberTest,
+AdditionOfTwoSignedLongsWorksCorrectlyWhenOverflowOccurs)
+{
+	EXPECT_EQ(I<long>(vmin<long>()), I<long>(vmax<long>()) + I<long>(1));
+	EXPECT_EQ(I<long>(-2), I<long>(vmax<long>()) + I<long>(vmax<long>()));
+	EXPECT_EQ(I<long>(vmax<long>()), I<long>(vmin<long>()) + I<long>(-1));
+	EXPECT_EQ(I<long>(0), I<long>(vmin<long>()) + I<long>(vmin<long>()));
+
+	// The wrapped sum can be used in further computation.
+	EXPECT_EQ(I<long>(vmin<long>() + 1),
+		(I<long>(vmax<long>()) + I<long>(1)) + I<long>(1));
+}
+
+TEST_F(NumberTest,
+AdditionOfTwoUnsignedLongsWorksCorrectlyWhenOverflowOccurs)
+{
+	EXPECT_EQ(I<unsigned long>(0),
+		I<unsigned long>(vmax<unsigned long>()) + I<unsigned long>(1));
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>() - 1),
+		I<unsigned long>(vmax<unsigned long>()) +
+		I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_EQ(I<unsigned long>(vmax<long>() + 1UL),
+		I<unsigned long>(vmax<long>()) + I<unsigned long>(1));
+	EXPECT_EQ(I<unsigned long>(1),
+		(I<unsigned long>(vmax<unsigned long>()) + I<unsigned long>(1)) +
+		I<unsigned long>(1));
+}
+
 TEST_F(NumberTest,
 AdditionOfFloatsWorksCorrectlyWhenAddingLimitNumbers)
 {
@@ -1450,6 +1603,29 @@ SubtractionOfTwoUnsignedIntsWorksCorrectlyWhenUnderflowOccurs)
 	EXPECT_EQ(I<unsigned>(1), I<unsigned>(0) - I<unsigned>(vmax<unsigned>()));
 }
 
+TEST_F(NumberTest,
+SubtractionOfTwoSignedLongsWorksCorrectlyWhenUnderflowOccurs)
+{
+	EXPECT_EQ(I<long>(vmax<long>()), I<long>(vmin<long>()) - I<long>(1));
+	EXPECT_EQ(I<long>(1), I<long>(vmin<long>()) - I<long>(vmax<long>()));
+	EXPECT_EQ(I<long>(vmin<long>()), I<long>(vmax<long>()) - I<long>(-1));
+
+	// The wrapped difference can be used in further computation.
+	EXPECT_EQ(I<long>(vmax<long>() - 1),
+		(I<long>(vmin<long>()) - I<long>(1)) - I<long>(1));
+}
+
+TEST_F(NumberTest,
+SubtractionOfTwoUnsignedLongsWorksCorrectlyWhenUnderflowOccurs)
+{
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>()),
+		I<unsigned long>(0) - I<unsigned long>(1));
+	EXPECT_EQ(I<unsigned long>(1),
+		I<unsigned long>(0) - I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_EQ(I<unsigned long>(vmax<long>() + 1UL),
+		I<unsigned long>(vmax<unsigned long>()) - I<unsigned long>(vmax<long>()));
+}
+
 TEST_F(NumberTest,
 SubtractionOfFloatsWorksCorrectlyWhenSubtractingLimitNumbers)
 {
@@ -1517,6 +1693,30 @@ MultiplicationOfTwoUnsignedIntsWorksCorrectlyWhenOverflowOccurs)
 		I<unsigned>(vmax<unsigned>()) * I<unsigned>(vmax<unsigned>()));
 }
 
+TEST_F(NumberTest,
+MultiplicationOfTwoSignedLongsWorksCorrectlyWhenOverflowOccurs)
+{
+	EXPECT_EQ(I<long>(-2), I<long>(vmax<long>()) * I<long>(2));
+	EXPECT_EQ(I<long>(1), I<long>(vmax<long>()) * I<long>(vmax<long>()));
+	EXPECT_EQ(I<long>(vmin<long>()), I<long>(vmin<long>()) * I<long>(-1));
+	EXPECT_EQ(I<long>(0), I<long>(vmin<long>()) * I<long>(2));
+
+	// The wrapped product can be used in further computation.
+	EXPECT_EQ(I<long>(-1), (I<long>(vmax<long>()) * I<long>(2)) + I<long>(1));
+}
+
+TEST_F(NumberTest,
+MultiplicationOfTwoUnsignedLongsWorksCorrectlyWhenOverflowOccurs)
+{
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>() - 1),
+		I<unsigned long>(vmax<unsigned long>()) * I<unsigned long>(2));
+	EXPECT_EQ(I<unsigned long>(1),
+		I<unsigned long>(vmax<unsigned long>()) *
+		I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_EQ(I<unsigned long>(0),
+		I<unsigned long>(vmax<long>() + 1UL) * I<unsigned long>(2));
+}
+
 TEST_F(NumberTest,
 MultiplicationOfUnsignedIntAndFloatWorksCorrectly)
 {
@@ -1748,9 +1948,28 @@ TruncDivisionOfIntsWithTheSameTypeWorksCorrectly)
 	EXPECT_EQ(I<long>(12 / 7), trunc_div(I<long>(12), I<long>(7)));
 	EXPECT_EQ(I<unsigned long>(5000 / 6),
 			  trunc_div(I<unsigned long>(5000), I<unsigned long>(6)));
+}
 
-	// Note: INT_MIN / -1 is not tested because its behaviour is undefined.
-	// EXPECT_EQ(I<int>(vmin<int>() / -1), trunc_div(I<int>(vmin<int>()), I<int>(-1)));
+TEST_F(NumberTest,
+TruncDivisionOfMinimalSignedIntByMinusOneIsStillMinimalSignedInt)
+{
+	// The quotient overflows (it is undefined in C), so it gets wrapped.
+	EXPECT_EQ(I<int>(vmin<int>()), trunc_div(I<int>(vmin<int>()), I<int>(-1)));
+	EXPECT_EQ(I<long>(vmin<long>()), trunc_div(I<long>(vmin<long>()), I<long>(-1)));
+	EXPECT_EQ(I<long>(-vmax<long>()), trunc_div(I<long>(vmax<long>()), I<long>(-1)));
+}
+
+TEST_F(NumberTest,
+TruncDivisionOfUnsignedLongsAboveLongMaxWorksCorrectly)
+{
+	EXPECT_EQ(I<unsigned long>(vmax<long>()),
+		trunc_div(I<unsigned long>(vmax<unsigned long>()), I<unsigned long>(2)));
+	EXPECT_EQ(I<unsigned long>(1),
+		trunc_div(I<unsigned long>(vmax<unsigned long>()),
+			I<unsigned long>(vmax<long>() + 1UL)));
+	EXPECT_EQ(I<unsigned long>(0),
+		trunc_div(I<unsigned long>(vmax<long>()),
+			I<unsigned long>(vmax<unsigned long>())));
 }
 
 TEST_F(NumberTest,
@@ -1817,6 +2036,25 @@ TruncModuloOfIntsWithTheSameTypeWorksCorrectly)
 			  trunc_mod(I<unsigned long>(5000), I<unsigned long>(6)));
 }
 
+TEST_F(NumberTest,
+TruncModuloByMinusOneIsZero)
+{
+	EXPECT_EQ(I<int>(0), trunc_mod(I<int>(vmin<int>()), I<int>(-1)));
+	EXPECT_EQ(I<int>(0), trunc_mod(I<int>(vmax<int>()), I<int>(-1)));
+	EXPECT_EQ(I<long>(0), trunc_mod(I<long>(vmin<long>()), I<long>(-1)));
+	EXPECT_EQ(I<long>(0), trunc_mod(I<long>(-12), I<long>(-1)));
+}
+
+TEST_F(NumberTest,
+TruncModuloOfUnsignedLongsAboveLongMaxWorksCorrectly)
+{
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>() % 10),
+		trunc_mod(I<unsigned long>(vmax<unsigned long>()), I<unsigned long>(10)));
+	EXPECT_EQ(I<unsigned long>(vmax<long>()),
+		trunc_mod(I<unsigned long>(vmax<unsigned long>()),
+			I<unsigned long>(vmax<long>() + 1UL)));
+}
+
 TEST_F(NumberTest,
 TruncModuloOfIntsWithTheDifferentTypesWorksCorrectly)
 {
@@ -2349,6 +2587,16 @@ BitNotOfIntWorksCorrectly)
 	EXPECT_EQ(I<int>(~(-12569)), bitNot(I<int>(-12569)));
 }
 
+TEST_F(NumberTest,
+BitNotOfUnsignedLongWorksCorrectly)
+{
+	EXPECT_EQ(I<unsigned long>(vmax<unsigned long>()), bitNot(I<unsigned long>(0)));
+	EXPECT_EQ(I<unsigned long>(0),
+		bitNot(I<unsigned long>(vmax<unsigned long>())));
+	EXPECT_EQ(I<unsigned long>(vmax<long>()),
+		bitNot(I<unsigned long>(vmax<long>() + 1UL)));
+}
+
 TEST_F(NumberTest,
 BitNotOfFloatWorksCorrectly)
 {
@@ -2371,6 +2619,19 @@ IntBitAndIntWorksCorrectly)
 	EXPECT_TRUE(I<int>(1 & 1) == bitAnd(I<int>(1), I<int>(1)));
 }
 
+TEST_F(NumberTest,
+UnsignedLongBitAndUnsignedLongWorksCorrectly)
+{
+	EXPECT_EQ(I<unsigned long>(0xFF),
+		bitAnd(I<unsigned long>(vmax<unsigned long>()), I<unsigned long>(0xFF)));
+	EXPECT_EQ(I<unsigned long>(vmax<long>() + 1UL),
+		bitAnd(I<unsigned long>(vmax<unsigned long>()),
+			I<unsigned long>(vmax<long>() + 1UL)));
+	EXPECT_EQ(I<unsigned long>(0),
+		bitAnd(I<unsigned long>(vmax<long>()),
+			I<unsigned long>(vmax<long>() + 1UL)));
+}
+
 TEST_F(NumberTest,
 IntBitAndFloatWorksCorrectly)
 {
@@ -8,7 +8,9 @@
 #undef NDEBUG   // It is necessary for using assertions.
 
 #include <iostream>
-#include <boost/foreach.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
 #include <cl/easy.hh>
 
 #include "ValueAnalysis.h"
@@ -20,10 +22,32 @@ extern "C" {
     __attribute__ ((__visibility__ ("default"))) int plugin_is_GPL_compatible;
 }
 
-using CodeStorage::Fnc;
 using CodeStorage::Storage;
 
-void clEasyRun(const Storage &stor, const char *)
+/**
+* @brief Returns the number of threads for the analysis of functions.
+*
+* It is set by the @c threads:<n> argument in @a configString. By default,
+* one thread per online CPU is used.
+*/
+static unsigned getNumberOfThreads(const char *configString)
+{
+	const char *arg = (configString != NULL) ?
+		std::strstr(configString, "threads:") : NULL;
+	if (arg != NULL) {
+		const long threads = std::strtol(arg + std::strlen("threads:"), NULL, 10);
+		if (threads > 0) {
+			return threads;
+		}
+
+		std::cerr << "vra: use \"threads:<n>\" with n > 0" << std::endl;
+	}
+
+	const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	return (cpus > 0) ? cpus : 1;
+}
+
+void clEasyRun(const Storage &stor, const char *configString)
 {
 	LoopFinder::computeLoopAnalysis(stor);
 	// LoopFinder::printLoopAnalysis(std::cout);
@@ -31,14 +55,7 @@ void clEasyRun(const Storage &stor, const char *)
 	GlobAnalysis::computeGlobAnalysis(stor);
 	// GlobAnalysis::printGlobAnalysis(std::cout);
 
-	BOOST_FOREACH(const Fnc* pFnc, stor.fncs) {
-		const Fnc &fnc = *pFnc;
-
-		if (!isDefined(fnc))
-			continue;
-
-		ValueAnalysis::computeAnalysisForFnc(fnc);
-	}
+	ValueAnalysis::computeAnalysis(stor, getNumberOfThreads(configString));
 
 	ValueAnalysis::printRanges(std::cout, stor);
 }